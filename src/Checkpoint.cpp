@@ -0,0 +1,153 @@
+#include "Checkpoint.h"
+#include <cstdio>
+#include <cstring>
+
+namespace tdenum {
+
+// Marks the beginning of a checkpoint file, followed by the format version
+static const char MAGIC[] = "TDENUMCP";
+static const uint64_t VERSION = 1;
+static const size_t BUFFER_SIZE = 1 << 20;
+
+CheckpointWriter::CheckpointWriter(const string& fileName) : fileName(fileName),
+		temporaryFileName(fileName + ".tmp"), failed(false) {
+	file.open(temporaryFileName.c_str(), ios::binary | ios::trunc);
+	failed = !file;
+	buffer.reserve(BUFFER_SIZE);
+	buffer.insert(buffer.end(), MAGIC, MAGIC + strlen(MAGIC));
+	writeNumber(VERSION);
+}
+
+/*
+ * A writer that was not closed leaves the previous checkpoint.
+ */
+CheckpointWriter::~CheckpointWriter() {
+	if (file.is_open()) {
+		file.close();
+		remove(temporaryFileName.c_str());
+	}
+}
+
+void CheckpointWriter::flush() {
+	if (!failed && !buffer.empty()) {
+		file.write(buffer.data(), buffer.size());
+		failed = !file;
+	}
+	buffer.clear();
+}
+
+void CheckpointWriter::writeNumber(uint64_t number) {
+	while (number >= 0x80) {
+		buffer.push_back((char)(number | 0x80));
+		number >>= 7;
+	}
+	buffer.push_back((char)number);
+	if (buffer.size() >= BUFFER_SIZE) {
+		flush();
+	}
+}
+
+/*
+ * Small negative numbers are mapped to small odd numbers.
+ */
+void CheckpointWriter::writeSignedNumber(int64_t number) {
+	writeNumber(((uint64_t)number << 1) ^ (uint64_t)(number >> 63));
+}
+
+void CheckpointWriter::writeDouble(double number) {
+	uint64_t bits;
+	memcpy(&bits, &number, sizeof(bits));
+	for (int i = 0; i < 8; i++) {
+		buffer.push_back((char)(bits >> (8*i)));
+	}
+}
+
+void CheckpointWriter::writeString(const string& s) {
+	writeNumber(s.size());
+	buffer.insert(buffer.end(), s.begin(), s.end());
+}
+
+bool CheckpointWriter::close() {
+	flush();
+	file.close();
+	failed = failed || !file;
+	if (failed) {
+		remove(temporaryFileName.c_str());
+		return false;
+	}
+	return rename(temporaryFileName.c_str(), fileName.c_str()) == 0;
+}
+
+
+
+CheckpointReader::CheckpointReader(const string& fileName) : failed(false) {
+	file.open(fileName.c_str(), ios::binary);
+	char magic[sizeof(MAGIC) - 1];
+	file.read(magic, sizeof(magic));
+	failed = !file || memcmp(magic, MAGIC, sizeof(magic)) != 0;
+	if (readNumber() != VERSION) {
+		fail();
+	}
+}
+
+uint64_t CheckpointReader::readNumber() {
+	uint64_t number = 0;
+	for (int shift = 0; !failed && shift < 64; shift += 7) {
+		int byte = file.get();
+		if (byte == EOF) {
+			fail();
+			break;
+		}
+		number |= (uint64_t)(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0) {
+			return number;
+		}
+	}
+	fail();
+	return 0;
+}
+
+int64_t CheckpointReader::readSignedNumber() {
+	uint64_t number = readNumber();
+	return (int64_t)(number >> 1) ^ -(int64_t)(number & 1);
+}
+
+double CheckpointReader::readDouble() {
+	unsigned char bytes[8];
+	file.read((char*)bytes, 8);
+	if (!file) {
+		fail();
+		return 0;
+	}
+	uint64_t bits = 0;
+	for (int i = 0; i < 8; i++) {
+		bits |= (uint64_t)bytes[i] << (8*i);
+	}
+	double number;
+	memcpy(&number, &bits, sizeof(number));
+	return number;
+}
+
+string CheckpointReader::readString() {
+	uint64_t size = readNumber();
+	string s;
+	for (uint64_t i = 0; i < size && !failed; i++) {
+		int c = file.get();
+		if (c == EOF) {
+			fail();
+		} else {
+			s.push_back((char)c);
+		}
+	}
+	return s;
+}
+
+void CheckpointReader::fail() {
+	failed = true;
+}
+
+bool CheckpointReader::isValid() const {
+	return !failed;
+}
+
+} /* namespace tdenum */
@@ -0,0 +1,89 @@
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+using namespace std;
+
+namespace tdenum {
+
+/**
+ * Writes the state of an enumeration to a binary file. Numbers are written as
+ * variable length integers of 7 bits per byte, and sorted sequences as the
+ * differences between consecutive numbers, so small sets of close ids take a
+ * byte per member. The file is written under a temporary name and renamed
+ * when it is closed, so a run stopped while writing leaves the previous
+ * checkpoint intact.
+ */
+class CheckpointWriter {
+	string fileName;
+	string temporaryFileName;
+	ofstream file;
+	// Bytes are collected here and written in large blocks
+	vector<char> buffer;
+	bool failed;
+	void flush();
+
+	CheckpointWriter(const CheckpointWriter&);
+	CheckpointWriter& operator=(const CheckpointWriter&);
+public:
+	CheckpointWriter(const string& fileName);
+	~CheckpointWriter();
+	void writeNumber(uint64_t number);
+	// Writes a number that may be negative
+	void writeSignedNumber(int64_t number);
+	void writeDouble(double number);
+	void writeString(const string& s);
+	// Writes a sequence of increasing numbers
+	template<class Iterator>
+	void writeSortedNumbers(Iterator begin, Iterator end, size_t size) {
+		writeNumber(size);
+		uint64_t previous = 0;
+		for (Iterator i = begin; i != end; ++i) {
+			writeNumber((uint64_t)*i - previous);
+			previous = *i;
+		}
+	}
+	// Finishes writing, and replaces the checkpoint file. Returns whether the
+	// checkpoint was written successfully.
+	bool close();
+};
+
+/**
+ * Reads a checkpoint written by CheckpointWriter. A failure to read, or a
+ * value that does not fit the state being loaded, marks the reader as
+ * failed, and the numbers read afterwards are 0.
+ */
+class CheckpointReader {
+	ifstream file;
+	bool failed;
+
+	CheckpointReader(const CheckpointReader&);
+	CheckpointReader& operator=(const CheckpointReader&);
+public:
+	CheckpointReader(const string& fileName);
+	uint64_t readNumber();
+	int64_t readSignedNumber();
+	double readDouble();
+	string readString();
+	// Reads a sequence of increasing numbers and appends it to the container
+	template<class T, class Container>
+	void readSortedNumbers(Container& numbers) {
+		uint64_t size = readNumber();
+		uint64_t previous = 0;
+		for (uint64_t i = 0; i < size && !failed; i++) {
+			previous += readNumber();
+			numbers.insert(numbers.end(), (T)previous);
+		}
+	}
+	// Marks the checkpoint as not matching the state being loaded
+	void fail();
+	// Returns whether everything was read successfully
+	bool isValid() const;
+};
+
+} /* namespace tdenum */
+
+#endif /* CHECKPOINT_H_ */
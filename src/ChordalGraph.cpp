@@ -7,7 +7,8 @@
 
 #include "ChordalGraph.h"
 #include "DataStructures.h"
-#include <map>
+#include "NodeBitset.h"
+#include <algorithm>
 #include <cmath>
 
 namespace tdenum {
@@ -30,11 +31,12 @@ ChordalGraph::~ChordalGraph() {}
  * is smaller or equal to the previous weight, it with its neighbors form a
  * clique.
  */
-set<NodeSet> ChordalGraph::getMaximalCliques() const {
+template<class G>
+set<NodeSet> maximalCliquesOf(const G& g) {
 	// initialize structures
 	set<NodeSet> cliques; // holds the result
-	map<Node, bool> isVisited; // default is false
-	IncreasingWeightNodeQueue queue(getNumberOfNodes());
+	NodeBitset isVisited(g.getNumberOfNodes());
+	IncreasingWeightNodeQueue queue(g.getNumberOfNodes());
 	int previousNumberOfNeighbors = -1;
 	Node previousNode = -1;
 	// start search
@@ -45,38 +47,43 @@ set<NodeSet> ChordalGraph::getMaximalCliques() const {
 		// Add a new clique if relevant
 		if (currentNumberOfNeighbors <= previousNumberOfNeighbors) {
 			// add currentNode and  its visited neighbors to cliques
-			NodeSetProducer cliqueProducer(getNumberOfNodes());
-			cliqueProducer.insert(previousNode);
-			for (set<Node>::iterator i = getNeighbors(previousNode).begin();
-					i!=getNeighbors(previousNode).end(); ++i) {
-				if (isVisited[*i]) {
-					cliqueProducer.insert(*i);
+			NodeSet clique;
+			for (Node v : g.getNeighbors(previousNode)) {
+				if (isVisited.contains(v)) {
+					clique.push_back(v);
 				}
 			}
-			cliques.insert(cliqueProducer.produce());
+			clique.insert(lower_bound(clique.begin(), clique.end(), previousNode), previousNode);
+			cliques.insert(clique);
 		}
 		// Update structures
-		for (set<Node>::iterator i = getNeighbors(currentNode).begin();
-				i!=getNeighbors(currentNode).end(); ++i) {
-			if (!isVisited[*i]) {
-				queue.increaseWeight(*i);
+		for (Node v : g.getNeighbors(currentNode)) {
+			if (!isVisited.contains(v)) {
+				queue.increaseWeight(v);
 			}
 		}
-		isVisited[currentNode] = true;
+		isVisited.insert(currentNode);
 		previousNumberOfNeighbors = currentNumberOfNeighbors;
 		previousNode = currentNode;
 	}
 	// add the last clique
-	NodeSetProducer cliqueProducer(getNumberOfNodes());
-	cliqueProducer.insert(previousNode);
-	for (set<Node>::iterator i = getNeighbors(previousNode).begin();
-			i!=getNeighbors(previousNode).end(); ++i) {
-		cliqueProducer.insert(*i);
+	NodeSet clique;
+	for (Node v : g.getNeighbors(previousNode)) {
+		clique.push_back(v);
 	}
-	cliques.insert(cliqueProducer.produce());
+	clique.insert(lower_bound(clique.begin(), clique.end(), previousNode), previousNode);
+	cliques.insert(clique);
 	return cliques;
 }
 
+set<NodeSet> ChordalGraph::getMaximalCliques() const {
+	return maximalCliquesOf(*this);
+}
+
+set<NodeSet> getMaximalCliques(const SaturatedGraph& g) {
+	return maximalCliquesOf(g);
+}
+
 vector< set<Node> > ChordalGraph::getFillEdges(const Graph& origin) const {
 	vector< set<Node> > edges;
 	for (Node v=0; v<getNumberOfNodes(); v++) {
@@ -97,8 +104,7 @@ int ChordalGraph::getFillIn(const Graph& origin) const {
 	return getNumberOfEdges() - origin.getNumberOfEdges();
 }
 
-int ChordalGraph::getTreeWidth() const {
-	set<NodeSet> maximalCliques = getMaximalCliques();
+int treeWidthOf(const set<NodeSet>& maximalCliques) {
 	int maxSize = 0;
 	for (set<NodeSet>::iterator i=maximalCliques.begin(); i!=maximalCliques.end(); ++i) {
 		if (maxSize < (int)(*i).size()) {
@@ -108,8 +114,7 @@ int ChordalGraph::getTreeWidth() const {
 	return maxSize - 1;
 }
 
-long long ChordalGraph::getExpBagsSize() const {
-	set<NodeSet> maximalCliques = getMaximalCliques();
+long long expBagsSizeOf(const set<NodeSet>& maximalCliques) {
 	long long result = 0;
 	for (set<NodeSet>::iterator i=maximalCliques.begin(); i!=maximalCliques.end(); ++i) {
 		result += pow((double)2,(double)(*i).size());
@@ -117,4 +122,20 @@ long long ChordalGraph::getExpBagsSize() const {
 	return result;
 }
 
+int ChordalGraph::getTreeWidth() const {
+	return treeWidthOf(getMaximalCliques());
+}
+
+int getTreeWidth(const SaturatedGraph& g) {
+	return treeWidthOf(getMaximalCliques(g));
+}
+
+long long ChordalGraph::getExpBagsSize() const {
+	return expBagsSizeOf(getMaximalCliques());
+}
+
+long long getExpBagsSize(const SaturatedGraph& g) {
+	return expBagsSizeOf(getMaximalCliques(g));
+}
+
 } /* namespace tdenum */
@@ -9,6 +9,7 @@
 #define CHORDALGRAPH_H_
 
 #include "Graph.h"
+#include "SaturatedGraph.h"
 
 namespace tdenum {
 
@@ -30,6 +31,11 @@ public:
 	long long getExpBagsSize() const;
 };
 
+// The metrics of ChordalGraph, for a chordal graph given as fill edges over a base graph
+set<NodeSet> getMaximalCliques(const SaturatedGraph& g);
+int getTreeWidth(const SaturatedGraph& g);
+long long getExpBagsSize(const SaturatedGraph& g);
+
 } /* namespace tdenum */
 
 #endif /* CHORDALGRAPH_H_ */
@@ -0,0 +1,275 @@
+#include "CompactGraph.h"
+#include "DenseGraph.h"
+#include "DataStructures.h"
+#include "NodeBitset.h"
+#include <algorithm>
+#include <iostream>
+
+namespace tdenum {
+
+CompactGraph::CompactGraph() : numberOfNodes(0), numberOfEdges(0), offsets(1, 0) {}
+
+CompactGraph::CompactGraph(const Graph& g) : numberOfNodes(g.getNumberOfNodes()),
+		numberOfEdges(g.getNumberOfEdges()), offsets(g.getNumberOfNodes()+1, 0) {
+	adjacency.reserve(2*numberOfEdges);
+	for (Node v=0; v<numberOfNodes; v++) {
+		const set<Node>& neighbors = g.getNeighbors(v);
+		adjacency.insert(adjacency.end(), neighbors.begin(), neighbors.end());
+		offsets[v+1] = adjacency.size();
+	}
+}
+
+CompactGraph::CompactGraph(const DenseGraph& g) : numberOfNodes(g.getNumberOfNodes()),
+		numberOfEdges(g.getNumberOfEdges()), offsets(g.getNumberOfNodes()+1, 0) {
+	adjacency.reserve(2*numberOfEdges);
+	for (Node v=0; v<numberOfNodes; v++) {
+		NodeRange neighbors = g.getNeighbors(v);
+		adjacency.insert(adjacency.end(), neighbors.begin(), neighbors.end());
+		offsets[v+1] = adjacency.size();
+	}
+}
+
+Graph CompactGraph::toGraph() const {
+	Graph g(numberOfNodes);
+	for (Node v=0; v<numberOfNodes; v++) {
+		for (Node u : getNeighbors(v)) {
+			if (v < u) {
+				g.addEdge(v, u);
+			}
+		}
+	}
+	return g;
+}
+
+bool CompactGraph::isValidNode(Node v) const {
+	if (v<0 || v>=numberOfNodes) {
+		cout << "Invalid input" << endl;
+		return false;
+	}
+	return true;
+}
+
+set<Node> CompactGraph::getNodes() const {
+	set<Node> nodes;
+	for (Node i=0; i<numberOfNodes; i++) {
+		nodes.insert(nodes.end(), i);
+	}
+	return nodes;
+}
+
+int CompactGraph::getNumberOfEdges() const {
+	return numberOfEdges;
+}
+
+int CompactGraph::getNumberOfNodes() const {
+	return numberOfNodes;
+}
+
+NodeRange CompactGraph::getNeighbors(Node v) const {
+	if (!isValidNode(v)) {
+		cout << "Error: Requesting access to invalid node" << endl;
+		return NodeRange();
+	}
+	const Node* base = adjacency.data();
+	return NodeRange(base + offsets[v], base + offsets[v+1]);
+}
+
+vector<bool> CompactGraph::getNeighborsMap(Node v) const {
+	vector<bool> result(numberOfNodes, false);
+	for (Node u : getNeighbors(v)) {
+		result[u] = true;
+	}
+	return result;
+}
+
+/*
+ * Returns the set of neighbors of nodes in the given node set without returning
+ * nodes that are in the input node set
+ */
+NodeSet CompactGraph::getNeighbors(const set<Node>& inputSet) const {
+	NodeSet neighbors;
+	getNeighbors(NodeSet(inputSet.begin(), inputSet.end()), neighbors);
+	return neighbors;
+}
+
+NodeSet CompactGraph::getNeighbors(const vector<Node>& inputSet) const {
+	NodeSet neighbors;
+	getNeighbors(inputSet, neighbors);
+	return neighbors;
+}
+
+void CompactGraph::getNeighbors(const vector<Node>& inputSet, NodeSet& neighbors) const {
+	neighbors.clear();
+	for (Node v : inputSet) {
+		if (!isValidNode(v)) {
+			return;
+		}
+	}
+	TraversalWorkspace& workspace = TraversalWorkspace::get(numberOfNodes);
+	for (Node v : inputSet) {
+		workspace.mark(v);
+	}
+	for (Node v : inputSet) {
+		for (Node u : getNeighbors(v)) {
+			if (workspace.markIfNew(u)) {
+				neighbors.push_back(u);
+			}
+		}
+	}
+	sort(neighbors.begin(), neighbors.end());
+}
+
+/*
+ * Neighbor lists are sorted, so this is a binary search.
+ */
+bool CompactGraph::areNeighbors(Node u, Node v) const {
+	const Node* first = adjacency.data() + offsets[u];
+	const Node* last = adjacency.data() + offsets[u+1];
+	return binary_search(first, last, v);
+}
+
+vector<NodeSet> CompactGraph::getComponents(const set<Node>& removedNodes) const {
+	return getComponents(NodeSet(removedNodes.begin(), removedNodes.end()));
+}
+
+vector<NodeSet> CompactGraph::getComponents(const NodeSet& removedNodes) const {
+	vector<NodeSet> components;
+	getComponents(removedNodes, components);
+	return components;
+}
+
+void CompactGraph::getComponents(const NodeSet& removedNodes, vector<NodeSet>& components) const {
+	for (Node v : removedNodes) {
+		if (!isValidNode(v)) {
+			components.clear();
+			return;
+		}
+	}
+	TraversalWorkspace& workspace = TraversalWorkspace::get(numberOfNodes);
+	for (Node v : removedNodes) {
+		workspace.mark(v);
+	}
+	collectComponents(workspace, numberOfNodes - removedNodes.size(), components);
+}
+
+vector<NodeSet> CompactGraph::getComponents(const NodeBitset& removedNodes) const {
+	vector<NodeSet> components;
+	getComponents(removedNodes, components);
+	return components;
+}
+
+void CompactGraph::getComponents(const NodeBitset& removedNodes, vector<NodeSet>& components) const {
+	TraversalWorkspace& workspace = TraversalWorkspace::get(numberOfNodes);
+	int numberOfRemovedNodes = 0;
+	for (Node v = 0; v < numberOfNodes; v++) {
+		if (removedNodes.contains(v)) {
+			workspace.mark(v);
+			numberOfRemovedNodes++;
+		}
+	}
+	collectComponents(workspace, numberOfNodes - numberOfRemovedNodes, components);
+}
+
+/*
+ * Each component is found by a BFS that appends its members to the component
+ * itself, which doubles as the BFS queue. Components are ordered by their
+ * smallest node, and sorted at the end.
+ */
+void CompactGraph::collectComponents(TraversalWorkspace& workspace,
+		int numberOfUnhandeledNodes, vector<NodeSet>& components) const {
+	unsigned int numberOfComponents = 0;
+	for (Node start = 0; start < numberOfNodes && numberOfUnhandeledNodes > 0; start++) {
+		if (!workspace.markIfNew(start)) {
+			continue;
+		}
+		if (numberOfComponents == components.size()) {
+			components.push_back(NodeSet());
+		}
+		NodeSet& component = components[numberOfComponents++];
+		component.clear();
+		component.push_back(start);
+		for (unsigned int head = 0; head < component.size(); head++) {
+			for (Node u : getNeighbors(component[head])) {
+				if (workspace.markIfNew(u)) {
+					component.push_back(u);
+				}
+			}
+		}
+		numberOfUnhandeledNodes -= component.size();
+		sort(component.begin(), component.end());
+	}
+	components.resize(numberOfComponents);
+}
+
+vector<int> CompactGraph::getComponentsMap(const vector<Node>& removedNodes) const {
+	vector<int> componentsMap;
+	getComponentsMap(removedNodes, componentsMap);
+	return componentsMap;
+}
+
+void CompactGraph::getComponentsMap(const vector<Node>& removedNodes,
+		vector<int>& componentsMap) const {
+	getComponentsMap(NodeRange(removedNodes.data(), removedNodes.data() + removedNodes.size()),
+			componentsMap);
+}
+
+void CompactGraph::getComponentsMap(NodeRange removedNodes,
+		vector<int>& componentsMap) const {
+	componentsMap.assign(numberOfNodes, 0);
+	for (Node v : removedNodes) {
+		if (!isValidNode(v)) {
+			componentsMap.clear();
+			return;
+		}
+		componentsMap[v] = -1;
+	}
+	vector<Node>& bfsQueue = TraversalWorkspace::get(numberOfNodes).getQueue();
+	int currentComponent = 1;
+	for (Node start = 0; start < numberOfNodes; start++) {
+		if (componentsMap[start] != 0) {
+			continue;
+		}
+		bfsQueue.clear();
+		bfsQueue.push_back(start);
+		componentsMap[start] = currentComponent;
+		for (unsigned int head = 0; head < bfsQueue.size(); head++) {
+			for (Node u : getNeighbors(bfsQueue[head])) {
+				if (componentsMap[u] == 0) {
+					componentsMap[u] = currentComponent;
+					bfsQueue.push_back(u);
+				}
+			}
+		}
+		currentComponent++;
+	}
+}
+
+set<Node> CompactGraph::getComponent(Node v, const set<Node>& removedNodes) const {
+	TraversalWorkspace& workspace = TraversalWorkspace::get(numberOfNodes);
+	vector<Node>& bfsQueue = workspace.getQueue();
+	for (Node removed : removedNodes) {
+		workspace.mark(removed);
+	}
+	bfsQueue.push_back(v);
+	workspace.mark(v);
+	for (unsigned int head = 0; head < bfsQueue.size(); head++) {
+		for (Node u : getNeighbors(bfsQueue[head])) {
+			if (workspace.markIfNew(u)) {
+				bfsQueue.push_back(u);
+			}
+		}
+	}
+	return set<Node>(bfsQueue.begin(), bfsQueue.end());
+}
+
+void CompactGraph::print() const {
+	for (Node v=0; v<numberOfNodes; v++) {
+		cout << v << " has neighbors: {";
+		for (Node u : getNeighbors(v)) {
+			cout << u << " ";
+		}
+		cout << "}" << endl;
+	}
+}
+
+} /* namespace tdenum */
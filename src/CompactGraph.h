@@ -0,0 +1,87 @@
+#ifndef COMPACTGRAPH_H_
+#define COMPACTGRAPH_H_
+
+#include "Graph.h"
+
+namespace tdenum {
+
+class DenseGraph;
+class NodeBitset;
+class TraversalWorkspace;
+
+/**
+ * An immutable graph stored in compressed sparse row form: the sorted
+ * neighbor lists of all the nodes are kept back to back in a single array.
+ * Provides the read API of Graph with a cache friendly layout, and is meant
+ * for graphs that are queried many times and never modified.
+ */
+class CompactGraph {
+	int numberOfNodes;
+	int numberOfEdges;
+	// The neighbors of v are adjacency[offsets[v]] ... adjacency[offsets[v+1]-1]
+	vector<int> offsets;
+	vector<Node> adjacency;
+
+	bool isValidNode(Node v) const;
+	// Stores in components the components of the nodes not marked in the
+	// workspace, given how many such nodes there are
+	void collectComponents(TraversalWorkspace& workspace, int numberOfUnhandeledNodes,
+			vector<NodeSet>& components) const;
+
+public:
+	// Constructs an empty graph
+	CompactGraph();
+	// Constructs a compact copy of the given graph
+	CompactGraph(const Graph& g);
+	// Constructs a compact copy of the given graph
+	CompactGraph(const DenseGraph& g);
+	// Returns a modifiable copy of this graph
+	Graph toGraph() const;
+
+	// Returns the nodes of the graph
+	set<Node> getNodes() const;
+	// Returns the number of edges in the graph
+	int getNumberOfEdges() const;
+	// Returns the number of nodes in the graph
+	int getNumberOfNodes() const;
+	// Returns the neighbors of the given node
+	NodeRange getNeighbors(Node v) const;
+	// Returns a vector the size of the number of nodes in the graph, stating
+	// whether the index nodes are neighbors of the input node.
+	vector<bool> getNeighborsMap(Node v) const;
+	// Returns the neighbors of the given node set
+	NodeSet getNeighbors(const vector<Node>& s) const;
+	// Returns the neighbors of the given node set
+	NodeSet getNeighbors(const set<Node>& s) const;
+	// Stores the neighbors of the given node set in neighbors, reusing its buffer
+	void getNeighbors(const vector<Node>& s, NodeSet& neighbors) const;
+	// Returns whether there is an edge between the given two nodes
+	bool areNeighbors(Node u, Node v) const;
+	// Returns a map from the Nodes numbers to the number of the component they are in.
+	// -1 if they are in the input set.
+	vector<int> getComponentsMap(const vector<Node>& removedNodes) const;
+	// Stores the map returned by getComponentsMap in componentsMap, reusing its buffer
+	void getComponentsMap(const vector<Node>& removedNodes, vector<int>& componentsMap) const;
+	void getComponentsMap(NodeRange removedNodes, vector<int>& componentsMap) const;
+	// Returns the set of components obtained by removing the given node set
+	vector<NodeSet> getComponents(const set<Node>& removedNodes) const;
+	// Returns the set of components obtained by removing the given node set
+	vector<NodeSet> getComponents(const NodeSet& removedNodes) const;
+	// Returns the set of components obtained by removing the given node set
+	vector<NodeSet> getComponents(const NodeBitset& removedNodes) const;
+	// Stores the components obtained by removing the given node set in
+	// components, reusing the buffers it already holds
+	void getComponents(const NodeSet& removedNodes, vector<NodeSet>& components) const;
+	// Stores the components obtained by removing the given node set in
+	// components, reusing the buffers it already holds
+	void getComponents(const NodeBitset& removedNodes, vector<NodeSet>& components) const;
+	// Returns all the nodes reachable from the node after removing
+	// the removedNodes from the graph
+	set<Node> getComponent(Node v, const set<Node>& removedNodes) const;
+	// Prints the graph
+	void print() const;
+};
+
+} /* namespace tdenum */
+
+#endif /* COMPACTGRAPH_H_ */
@@ -0,0 +1,90 @@
+#include "ComponentMapCache.h"
+
+namespace tdenum {
+
+ComponentMapCache::ComponentMapCache(size_t budget) : budget(budget), bytesUsed(0),
+		first(-1), last(-1), hits(0), misses(0) {}
+
+void ComponentMapCache::unlink(SeparatorId id) {
+	if (previous[id] == -1) {
+		first = next[id];
+	} else {
+		next[previous[id]] = next[id];
+	}
+	if (next[id] == -1) {
+		last = previous[id];
+	} else {
+		previous[next[id]] = previous[id];
+	}
+}
+
+void ComponentMapCache::pushFront(SeparatorId id) {
+	previous[id] = -1;
+	next[id] = first;
+	if (first == -1) {
+		last = id;
+	} else {
+		previous[first] = id;
+	}
+	first = id;
+}
+
+/*
+ * A hit moves the separator to the front of the list.
+ */
+const vector<uint16_t>* ComponentMapCache::find(SeparatorId id) {
+	if (id >= labels.size() || labels[id].empty()) {
+		misses++;
+		return NULL;
+	}
+	hits++;
+	if ((int)id != first) {
+		unlink(id);
+		pushFront(id);
+	}
+	return &labels[id];
+}
+
+/*
+ * Drops the least recently used maps until the new one fits.
+ */
+void ComponentMapCache::insert(SeparatorId id, const vector<int>& componentsMap) {
+	size_t size = componentsMap.size() * sizeof(uint16_t);
+	if (size == 0 || size > budget) {
+		return;
+	}
+	if (id < labels.size() && !labels[id].empty()) {
+		return;
+	}
+	vector<uint16_t> compactMap(componentsMap.size());
+	for (unsigned int v = 0; v < componentsMap.size(); v++) {
+		if (componentsMap[v] >= 65535) {
+			return;
+		}
+		compactMap[v] = componentsMap[v] < 0 ? 0 : componentsMap[v];
+	}
+	while (bytesUsed + size > budget) {
+		int dropped = last;
+		unlink(dropped);
+		bytesUsed -= labels[dropped].size() * sizeof(uint16_t);
+		vector<uint16_t>().swap(labels[dropped]);
+	}
+	if (id >= labels.size()) {
+		labels.resize(id+1);
+		previous.resize(id+1, -1);
+		next.resize(id+1, -1);
+	}
+	labels[id].swap(compactMap);
+	bytesUsed += size;
+	pushFront(id);
+}
+
+long long ComponentMapCache::getNumberOfHits() const {
+	return hits;
+}
+
+long long ComponentMapCache::getNumberOfMisses() const {
+	return misses;
+}
+
+} /* namespace tdenum */
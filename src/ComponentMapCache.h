@@ -0,0 +1,50 @@
+#ifndef COMPONENTMAPCACHE_H_
+#define COMPONENTMAPCACHE_H_
+
+#include "SeparatorPool.h"
+#include <stdint.h>
+
+namespace tdenum {
+
+// The default memory budget of a ComponentMapCache
+const size_t DEFAULT_COMPONENT_MAP_CACHE_BYTES = 64 << 20;
+
+/**
+ * Keeps the components map of the graph without a separator for recently used
+ * separators, within a memory budget. A map holds a label for every node: 0 for
+ * the nodes of the separator, and the number of the component, from 1, for the
+ * others. The labels take 16 bits, so maps with 65535 components or more are
+ * not kept. When the budget is exceeded, the least recently used maps are
+ * dropped.
+ */
+class ComponentMapCache {
+	size_t budget;
+	size_t bytesUsed;
+	// The labels of the cached maps by separator id, empty if not cached
+	vector< vector<uint16_t> > labels;
+	// A list of the cached separators, from the most to the least recently
+	// used, linked through previous and next. -1 ends the list.
+	vector<int> previous;
+	vector<int> next;
+	int first;
+	int last;
+	long long hits;
+	long long misses;
+	void unlink(SeparatorId id);
+	void pushFront(SeparatorId id);
+public:
+	// Initialization with the given budget in bytes. A budget of 0 disables the cache.
+	ComponentMapCache(size_t budget = DEFAULT_COMPONENT_MAP_CACHE_BYTES);
+	// Returns the cached labels of the separator, or NULL if they are not
+	// cached. Counts a hit or a miss.
+	const vector<uint16_t>* find(SeparatorId id);
+	// Caches the components map of the separator, where -1 marks its nodes,
+	// as returned by CompactGraph::getComponentsMap
+	void insert(SeparatorId id, const vector<int>& componentsMap);
+	long long getNumberOfHits() const;
+	long long getNumberOfMisses() const;
+};
+
+} /* namespace tdenum */
+
+#endif /* COMPONENTMAPCACHE_H_ */
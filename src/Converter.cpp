@@ -1,8 +1,6 @@
 #include "Converter.h"
 #include "DataStructures.h"
-#include <queue>
-#include <map>
-#include <utility>
+#include "NodeBitset.h"
 
 namespace tdenum {
 
@@ -16,6 +14,32 @@ ChordalGraph Converter::minimalSeparatorsToTriangulation(const Graph& g,
 	return ChordalGraph(triangulation);
 }
 
+SaturatedGraph Converter::minimalSeparatorsToSaturatedGraph(const Graph& g,
+		const set<MinimalSeparator>& minimalSeparators) {
+	SaturatedGraph triangulation(g);
+	triangulation.saturateNodeSets(minimalSeparators);
+	return triangulation;
+}
+
+ChordalGraph Converter::minimalSeparatorsToTriangulation(const Graph& g,
+		const SeparatorPool& pool, const set<SeparatorId>& minimalSeparators) {
+	Graph triangulation(g);
+	for (SeparatorId id : minimalSeparators) {
+		triangulation.addClique(pool.getSeparator(id));
+	}
+	return ChordalGraph(triangulation);
+}
+
+SaturatedGraph Converter::minimalSeparatorsToSaturatedGraph(const Graph& g,
+		const SeparatorPool& pool, const set<SeparatorId>& minimalSeparators,
+		const DenseGraph* denseGraph) {
+	SaturatedGraph triangulation(g, denseGraph);
+	for (SeparatorId id : minimalSeparators) {
+		triangulation.addClique(pool.get(id));
+	}
+	return triangulation;
+}
+
 /*
  * Input: a chordal graph
  *
@@ -28,11 +52,11 @@ ChordalGraph Converter::minimalSeparatorsToTriangulation(const Graph& g,
  * is smaller or equal to the previous weight, these neighbors form a minimal
  * separator.
  */
-set<MinimalSeparator> Converter::triangulationToMinimalSeparators(
-		const ChordalGraph& g) {
+template<class G>
+set<MinimalSeparator> minimalSeparatorsOfChordalGraph(const G& g) {
 	// initialize structures
 	set<MinimalSeparator> minimalSeparators; // holds the result
-	map<Node, bool> isVisited; // default is false
+	NodeBitset isVisited(g.getNumberOfNodes());
 	IncreasingWeightNodeQueue queue(g.getNumberOfNodes());
 	int previousNumberOfNeighbors = -1;
 	// start search
@@ -43,30 +67,37 @@ set<MinimalSeparator> Converter::triangulationToMinimalSeparators(
 		// Add a new minimal separator if relevant
 		if (currentNumberOfNeighbors <= previousNumberOfNeighbors) {
 			// add visited neighbors of currentNode to minimalSeparators
-			NodeSetProducer separatorProducer(g.getNumberOfNodes());
-			for (set<Node>::iterator i = g.getNeighbors(currentNode).begin();
-					i!=g.getNeighbors(currentNode).end(); ++i) {
-				if (isVisited[*i]) {
-					separatorProducer.insert(*i);
+			MinimalSeparator currentSeparator;
+			for (Node v : g.getNeighbors(currentNode)) {
+				if (isVisited.contains(v)) {
+					currentSeparator.push_back(v);
 				}
 			}
-			MinimalSeparator currentSeparator = separatorProducer.produce();
 			if (!currentSeparator.empty()) {
 				minimalSeparators.insert(currentSeparator);
 			}
 		}
 		// Update structures
-		for (set<Node>::iterator i = g.getNeighbors(currentNode).begin();
-				i!=g.getNeighbors(currentNode).end(); ++i) {
-			if (!isVisited[*i]) {
-				queue.increaseWeight(*i);
+		for (Node v : g.getNeighbors(currentNode)) {
+			if (!isVisited.contains(v)) {
+				queue.increaseWeight(v);
 			}
 		}
-		isVisited[currentNode] = true;
+		isVisited.insert(currentNode);
 		previousNumberOfNeighbors = currentNumberOfNeighbors;
 	}
 	return minimalSeparators;
 }
 
+set<MinimalSeparator> Converter::triangulationToMinimalSeparators(
+		const ChordalGraph& triangulation) {
+	return minimalSeparatorsOfChordalGraph(triangulation);
+}
+
+set<MinimalSeparator> Converter::triangulationToMinimalSeparators(
+		const SaturatedGraph& triangulation) {
+	return minimalSeparatorsOfChordalGraph(triangulation);
+}
+
 } /* namespace tdenum */
 
@@ -3,6 +3,8 @@
 
 #include "Graph.h"
 #include "ChordalGraph.h"
+#include "SaturatedGraph.h"
+#include "SeparatorPool.h"
 #include <set>
 
 namespace tdenum {
@@ -23,6 +25,19 @@ public:
 	 */
 	static ChordalGraph minimalSeparatorsToTriangulation(const Graph& g,
 			const set<MinimalSeparator>& minimalSeparators);
+	/**
+	 * Same as minimalSeparatorsToTriangulation, but the triangulation
+	 * references g and stores only the fill edges.
+	 */
+	static SaturatedGraph minimalSeparatorsToSaturatedGraph(const Graph& g,
+			const set<MinimalSeparator>& minimalSeparators);
+	// Same as above, for the minimal separators with the given ids in the pool.
+	// The edges of g are tested in denseGraph if given, which must be a copy of g.
+	static ChordalGraph minimalSeparatorsToTriangulation(const Graph& g,
+			const SeparatorPool& pool, const set<SeparatorId>& minimalSeparators);
+	static SaturatedGraph minimalSeparatorsToSaturatedGraph(const Graph& g,
+			const SeparatorPool& pool, const set<SeparatorId>& minimalSeparators,
+			const DenseGraph* denseGraph = NULL);
 	/**
 	 * Receives a chordal graph, and returns its minimal separators.
 	 * If this is a minimal triagulation of some other graph, the result is a
@@ -30,6 +45,8 @@ public:
 	 */
 	static set<MinimalSeparator> triangulationToMinimalSeparators(
 			const ChordalGraph& triangulation);
+	static set<MinimalSeparator> triangulationToMinimalSeparators(
+			const SaturatedGraph& triangulation);
 };
 
 } /* namespace tdenum */
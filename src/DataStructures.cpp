@@ -6,22 +6,41 @@
  */
 
 #include "DataStructures.h"
+#include <stdint.h>
 
 namespace tdenum {
 
-IncreasingWeightNodeQueue::IncreasingWeightNodeQueue(int numberOfNodes) :
-		weight(numberOfNodes, 0) {
-	vector< pair<int,Node> > temporaryQueue;
-	for (Node v = 0; v<numberOfNodes; v++) {
-		temporaryQueue.push_back(pair<int,Node> (0,v));
+IncreasingWeightNodeQueue::IncreasingWeightNodeQueue(int numberOfNodes) {
+	reset(numberOfNodes);
+}
+
+/*
+ * Nodes in decreasing order form a heap.
+ */
+void IncreasingWeightNodeQueue::reset(int numberOfNodes) {
+	weight.assign(numberOfNodes, 0);
+	isPopped.assign(numberOfNodes, false);
+	for (unsigned int i = 0; i < buckets.size(); i++) {
+		buckets[i].clear();
+	}
+	if (buckets.empty()) {
+		buckets.resize(1);
 	}
-	queue = set< pair<int,Node> >(temporaryQueue.begin(), temporaryQueue.end());
+	for (Node v = numberOfNodes-1; v >= 0; v--) {
+		buckets[0].push_back(v);
+	}
+	maxWeight = 0;
+	numberOfNodesLeft = numberOfNodes;
 }
 
 void IncreasingWeightNodeQueue::increaseWeight(Node v) {
-	queue.erase(pair<int,Node> (weight[v],v));
 	weight[v]++;
-	queue.insert(pair<int,Node> (weight[v],v));
+	if (weight[v] >= (int)buckets.size()) {
+		buckets.resize(weight[v]+1);
+	}
+	buckets[weight[v]].push_back(v);
+	push_heap(buckets[weight[v]].begin(), buckets[weight[v]].end());
+	maxWeight = max(maxWeight, weight[v]);
 }
 
 int IncreasingWeightNodeQueue::getWeight(Node v) {
@@ -29,46 +48,237 @@ int IncreasingWeightNodeQueue::getWeight(Node v) {
 }
 
 bool IncreasingWeightNodeQueue::isEmpty() {
-	return queue.empty();
+	return numberOfNodesLeft == 0;
 }
 
 Node IncreasingWeightNodeQueue::pop() {
-	pair<int,Node> current = *queue.rbegin();
-	Node v = current.second;
-	queue.erase(current);
-	return v;
+	while (true) {
+		NodeSet& bucket = buckets[maxWeight];
+		if (bucket.empty()) {
+			maxWeight--;
+			continue;
+		}
+		pop_heap(bucket.begin(), bucket.end());
+		Node v = bucket.back();
+		bucket.pop_back();
+		if (!isPopped[v] && weight[v] == maxWeight) {
+			isPopped[v] = true;
+			numberOfNodesLeft--;
+			return v;
+		}
+	}
 }
 
 
 
+size_t NodeSetHash::operator()(const NodeSet& nodeSet) const {
+	return (*this)(NodeRange(nodeSet.data(), nodeSet.data() + nodeSet.size()));
+}
+
+size_t NodeSetHash::operator()(NodeRange nodes) const {
+	return hashRange(nodes.begin(), nodes.end(), nodes.size(), 0x9e3779b97f4a7c15ULL);
+}
+
+
+
+NodeSetIndex::NodeSetIndex() : numberOfUsedSlots(0), numberOfMembers(0) {}
+
+uint64_t NodeSetIndex::getFingerprint(const NodeSet& nodeSet) const {
+	uint64_t fingerprint = NodeSetHash()(nodeSet);
+	return fingerprint == 0 ? 1 : fingerprint;
+}
+
+int NodeSetIndex::find(const NodeSet& nodeSet) const {
+	if (fingerprints.empty()) {
+		return -1;
+	}
+	uint64_t fingerprint = getFingerprint(nodeSet);
+	size_t mask = fingerprints.size() - 1;
+	for (size_t slot = fingerprint & mask; fingerprints[slot] != 0; slot = (slot+1) & mask) {
+		if (fingerprints[slot] == fingerprint && slotIds[slot] != -1 &&
+				nodeSets[slotIds[slot]] == nodeSet) {
+			return slotIds[slot];
+		}
+	}
+	return -1;
+}
+
+/*
+ * Keeps at most half of the slots used, counting removed ones.
+ */
+int NodeSetIndex::insert(const NodeSet& nodeSet) {
+	int id = find(nodeSet);
+	if (id != -1) {
+		return id;
+	}
+	if (2*(numberOfUsedSlots+1) > (int)fingerprints.size()) {
+		size_t numberOfSlots = max((size_t)16, fingerprints.size());
+		while (4*(numberOfMembers+1) > (int)numberOfSlots) {
+			numberOfSlots *= 2;
+		}
+		rehash(numberOfSlots);
+	}
+	if (freeIds.empty()) {
+		id = nodeSets.size();
+		nodeSets.push_back(nodeSet);
+		slotOfId.push_back(-1);
+	} else {
+		id = freeIds.back();
+		freeIds.pop_back();
+		nodeSets[id] = nodeSet;
+	}
+	uint64_t fingerprint = getFingerprint(nodeSet);
+	size_t mask = fingerprints.size() - 1;
+	size_t slot = fingerprint & mask;
+	while (fingerprints[slot] != 0) {
+		slot = (slot+1) & mask;
+	}
+	fingerprints[slot] = fingerprint;
+	slotIds[slot] = id;
+	slotOfId[id] = slot;
+	numberOfUsedSlots++;
+	numberOfMembers++;
+	return id;
+}
+
+void NodeSetIndex::remove(int id) {
+	slotIds[slotOfId[id]] = -1;
+	slotOfId[id] = -1;
+	NodeSet().swap(nodeSets[id]);
+	freeIds.push_back(id);
+	numberOfMembers--;
+}
+
+void NodeSetIndex::rehash(size_t numberOfSlots) {
+	vector<uint64_t> oldFingerprints(numberOfSlots, 0);
+	vector<int> oldSlotIds(numberOfSlots, -1);
+	oldFingerprints.swap(fingerprints);
+	oldSlotIds.swap(slotIds);
+	size_t mask = numberOfSlots - 1;
+	numberOfUsedSlots = 0;
+	for (size_t i = 0; i < oldFingerprints.size(); i++) {
+		if (oldFingerprints[i] == 0 || oldSlotIds[i] == -1) {
+			continue;
+		}
+		size_t slot = oldFingerprints[i] & mask;
+		while (fingerprints[slot] != 0) {
+			slot = (slot+1) & mask;
+		}
+		fingerprints[slot] = oldFingerprints[i];
+		slotIds[slot] = oldSlotIds[i];
+		slotOfId[oldSlotIds[i]] = slot;
+		numberOfUsedSlots++;
+	}
+}
+
+
+
+WeightedNodeSetQueue::WeightedNodeSetQueue() : minWeight(0) {}
+
 bool WeightedNodeSetQueue::isEmpty() {
-	return queue.empty();
+	return members.size() == 0;
 }
 
 bool WeightedNodeSetQueue::isMember(const vector<Node>& nodeSet, int weight) {
-	return queue.find(make_pair(weight, nodeSet)) != queue.end();
+	int id = members.find(nodeSet);
+	return id != -1 && weights[id] == weight;
+}
+
+bool WeightedNodeSetQueue::contains(const vector<Node>& nodeSet) const {
+	return members.find(nodeSet) != -1;
 }
 
 void WeightedNodeSetQueue::insert(const vector<Node>& nodeSet, int weight) {
-	queue.insert(make_pair(weight, nodeSet));
+	int numberOfMembers = members.size();
+	int id = members.insert(nodeSet);
+	if (members.size() == numberOfMembers) {
+		return;
+	}
+	if (id >= (int)weights.size()) {
+		weights.resize(id+1);
+	}
+	weights[id] = weight;
+	if (weight >= (int)buckets.size()) {
+		buckets.resize(weight+1);
+		bucketHeads.resize(weight+1, 0);
+	}
+	buckets[weight].push_back(id);
+	if (numberOfMembers == 0 || weight < minWeight) {
+		minWeight = weight;
+	}
 }
 
 vector<Node> WeightedNodeSetQueue::pop() {
-	vector<Node> nodeSet = queue.begin()->second;
-	queue.erase(queue.begin());
+	while (bucketHeads[minWeight] == buckets[minWeight].size()) {
+		minWeight++;
+	}
+	vector<int>& bucket = buckets[minWeight];
+	int id = bucket[bucketHeads[minWeight]++];
+	if (bucketHeads[minWeight] == bucket.size()) {
+		bucket.clear();
+		bucketHeads[minWeight] = 0;
+	}
+	vector<Node> nodeSet = members.get(id);
+	members.remove(id);
 	return nodeSet;
 }
 
+/*
+ * The buckets are FIFO, so inserting the node sets in this order restores
+ * the order they are popped in.
+ */
+void WeightedNodeSetQueue::save(CheckpointWriter& output) const {
+	output.writeNumber(members.size());
+	for (unsigned int weight = 0; weight < buckets.size(); weight++) {
+		for (size_t i = bucketHeads[weight]; i < buckets[weight].size(); i++) {
+			const NodeSet& nodeSet = members.get(buckets[weight][i]);
+			output.writeNumber(weight);
+			output.writeSortedNumbers(nodeSet.begin(), nodeSet.end(), nodeSet.size());
+		}
+	}
+}
+
+void WeightedNodeSetQueue::load(CheckpointReader& input) {
+	*this = WeightedNodeSetQueue();
+	uint64_t size = input.readNumber();
+	for (uint64_t i = 0; i < size && input.isValid(); i++) {
+		int weight = input.readNumber();
+		NodeSet nodeSet;
+		input.readSortedNumbers<Node>(nodeSet);
+		insert(nodeSet, weight);
+	}
+}
+
 
 
-bool NodeSetSet::isMember(const vector<Node>& nodeSet) {
-	return sets.find(nodeSet) != sets.end();
+bool NodeSetSet::isMember(const vector<Node>& nodeSet) const {
+	return sets.find(nodeSet) != -1;
 }
 
 void NodeSetSet::insert(const vector<Node>& nodeSet) {
 	sets.insert(nodeSet);
 }
 
+void NodeSetSet::save(CheckpointWriter& output) const {
+	output.writeNumber(sets.size());
+	for (int id = 0; id < sets.getIdBound(); id++) {
+		if (sets.isUsed(id)) {
+			const NodeSet& nodeSet = sets.get(id);
+			output.writeSortedNumbers(nodeSet.begin(), nodeSet.end(), nodeSet.size());
+		}
+	}
+}
+
+void NodeSetSet::load(CheckpointReader& input) {
+	sets = NodeSetIndex();
+	uint64_t size = input.readNumber();
+	for (uint64_t i = 0; i < size && input.isValid(); i++) {
+		NodeSet nodeSet;
+		input.readSortedNumbers<Node>(nodeSet);
+		sets.insert(nodeSet);
+	}
+}
+
 
 
 NodeSetProducer::NodeSetProducer(int sizeOfOriginalNodeSet) :
@@ -92,4 +302,28 @@ NodeSet NodeSetProducer::produce() {
 	return members;
 }
 
+
+
+
+TraversalWorkspace::TraversalWorkspace() : epoch(0) {}
+
+TraversalWorkspace& TraversalWorkspace::get(int numberOfNodes) {
+	static thread_local TraversalWorkspace workspace;
+	if ((int)workspace.stamps.size() < numberOfNodes) {
+		workspace.stamps.resize(numberOfNodes, 0);
+	}
+	workspace.newEpoch();
+	workspace.queue.clear();
+	return workspace;
+}
+
+void TraversalWorkspace::newEpoch() {
+	epoch++;
+	if (epoch == 0) {
+		// The counter wrapped around, so old stamps may look current
+		fill(stamps.begin(), stamps.end(), 0);
+		epoch = 1;
+	}
+}
+
 } /* namespace tdenum */
@@ -9,9 +9,13 @@
 #define DATASTRUCTURES_H_
 
 #include "Graph.h"
+#include "Checkpoint.h"
 #include <vector>
 #include <set>
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdint.h>
 
 using namespace std;
 
@@ -19,12 +23,23 @@ namespace tdenum {
 
 /*
  * A maximum heap. Can be used for Maximum Cardinality Search.
+ * The nodes are kept in buckets by their weights, and every bucket is a heap
+ * of nodes, so of the nodes with the maximal weight the largest is returned
+ * first. A node whose weight is increased is added to the next bucket, and
+ * its entry in the previous bucket is dropped when it reaches the top.
  */
 class IncreasingWeightNodeQueue {
 	vector<int> weight;
-	set< pair<int,Node> > queue;
+	vector<bool> isPopped;
+	vector<NodeSet> buckets;
+	// The largest weight whose bucket may have nodes
+	int maxWeight;
+	int numberOfNodesLeft;
 public:
-	IncreasingWeightNodeQueue(int numberOfNodes);
+	IncreasingWeightNodeQueue(int numberOfNodes = 0);
+	// Starts over with the given number of nodes of weight 0. The memory of
+	// the buckets is reused.
+	void reset(int numberOfNodes);
 	// Increase the weight of the node by 1.
 	// Node is assumed to be an integer between 0 and numberOfNodes-1.
 	void increaseWeight(Node v);
@@ -38,31 +53,111 @@ public:
 };
 
 /*
- * A minimum heap.
+ * Returns a 64 bit hash of the integers in the range, mixing every one into
+ * the hash with a multiply and xor-shift step. Sets are hashed in ascending
+ * order. Different seeds give independent hashes.
+ */
+template<class Iterator>
+uint64_t hashRange(Iterator begin, Iterator end, size_t size, uint64_t seed) {
+	typedef typename iterator_traits<Iterator>::value_type Element;
+	uint64_t hash = seed ^ size;
+	for (; begin != end; ++begin) {
+		hash ^= (uint64_t)std::hash<Element>()(*begin) + 0x9e3779b97f4a7c15ULL +
+				(hash << 6) + (hash >> 2);
+		hash *= 0xff51afd7ed558ccdULL;
+		hash ^= hash >> 32;
+	}
+	return hash;
+}
+
+/*
+ * A 64 bit hash of a node set.
+ */
+struct NodeSetHash {
+	size_t operator()(const NodeSet& nodeSet) const;
+	size_t operator()(NodeRange nodes) const;
+};
+
+/*
+ * Assigns ids to node sets, using an open addressing hash table with linear
+ * probing. Every slot holds the 64 bit fingerprint of a node set and its id,
+ * and the node sets themselves are compared only when the fingerprints match.
+ * The ids of removed node sets are reused.
+ */
+class NodeSetIndex {
+	// A fingerprint of 0 marks an empty slot, and an id of -1 a removed one
+	vector<uint64_t> fingerprints;
+	vector<int> slotIds;
+	int numberOfUsedSlots;
+	vector<NodeSet> nodeSets;
+	vector<int> slotOfId;
+	vector<int> freeIds;
+	int numberOfMembers;
+	uint64_t getFingerprint(const NodeSet& nodeSet) const;
+	// Rebuilds the table with the given number of slots, a power of 2
+	void rehash(size_t numberOfSlots);
+public:
+	NodeSetIndex();
+	// Returns the id of the given node set, or -1 if it is not contained.
+	int find(const NodeSet& nodeSet) const;
+	// Adds the given node set if it is not contained, and returns its id.
+	int insert(const NodeSet& nodeSet);
+	// Removes the node set with the given id.
+	void remove(int id);
+	// Returns the node set with the given id.
+	const NodeSet& get(int id) const { return nodeSets[id]; }
+	// Returns the number of node sets contained.
+	int size() const { return numberOfMembers; }
+	// Returns the bound on the ids, some of which may be removed.
+	int getIdBound() const { return nodeSets.size(); }
+	// True if the given id below the bound is of a contained node set.
+	bool isUsed(int id) const { return slotOfId[id] != -1; }
+};
+
+/*
+ * A minimum heap for small non-negative integer weights. Keeps a FIFO bucket
+ * for every weight, and a node set is contained at most once.
  */
 class WeightedNodeSetQueue {
-	set< pair<int, NodeSet > > queue;
+	NodeSetIndex members;
+	vector<int> weights;
+	// The ids of the node sets of every weight, where the ones before the
+	// head index were already popped
+	vector< vector<int> > buckets;
+	vector<size_t> bucketHeads;
+	int minWeight;
 public:
+	WeightedNodeSetQueue();
 	// True if the structure is empty.
 	bool isEmpty();
 	// True if the structure contains the given node set with the given weight.
 	bool isMember(const NodeSet& nodeSet, int weight);
-	// Adds the given node set to the structure with the given weight.
+	// True if the structure contains the given node set with any weight.
+	bool contains(const NodeSet& nodeSet) const;
+	// Adds the given node set to the structure with the given weight, unless
+	// it is already contained.
 	void insert(const NodeSet& nodeSet, int weight);
-	// Returns the maximal weighted node set, and removes it from the structure.
+	// Returns the minimal weighted node set, and removes it from the structure.
 	NodeSet pop();
+	// Writes the node sets with their weights, in the order they would be popped.
+	void save(CheckpointWriter& output) const;
+	// Replaces the contents with the saved node sets.
+	void load(CheckpointReader& input);
 };
 
 class NodeSetSet {
-	set< NodeSet > sets;
+	NodeSetIndex sets;
 public:
     // True if the structure contains the given node set.
-	bool isMember(const NodeSet& nodeSet);
+	bool isMember(const NodeSet& nodeSet) const;
 	// Adds the given node set to the structure.
 	void insert(const NodeSet& nodeSet);
+	// Writes the node sets contained.
+	void save(CheckpointWriter& output) const;
+	// Replaces the contents with the saved node sets.
+	void load(CheckpointReader& input);
 };
 
-
 /*
  * Constructs a subset of nodes in linear time in the size of the original set.
  */
@@ -80,6 +175,36 @@ public:
 	NodeSet produce();
 };
 
+/*
+ * Scratch space for graph traversals, kept per thread and reused between
+ * calls. A node is marked when its stamp equals the current epoch, so all
+ * the marks are cleared in O(1) by starting a new epoch.
+ */
+class TraversalWorkspace {
+	vector<unsigned int> stamps;
+	unsigned int epoch;
+	vector<Node> queue;
+	TraversalWorkspace();
+public:
+	// Returns the workspace of the calling thread, with room for the given
+	// number of nodes and a new epoch started.
+	static TraversalWorkspace& get(int numberOfNodes);
+	// Unmarks all the nodes.
+	void newEpoch();
+	void mark(Node v) { stamps[v] = epoch; }
+	bool isMarked(Node v) const { return stamps[v] == epoch; }
+	// Marks the node and returns true if it was not marked before.
+	bool markIfNew(Node v) {
+		if (stamps[v] == epoch) {
+			return false;
+		}
+		stamps[v] = epoch;
+		return true;
+	}
+	// A buffer for BFS queues, empty when the workspace is returned by get.
+	vector<Node>& getQueue() { return queue; }
+};
+
 } /* namespace tdenum */
 
 #endif /* DATASTRUCTURES_H_ */
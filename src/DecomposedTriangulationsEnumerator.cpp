@@ -0,0 +1,216 @@
+#include "DecomposedTriangulationsEnumerator.h"
+#include "GraphDecomposer.h"
+
+namespace tdenum {
+
+/*
+ * Initialization
+ */
+DecomposedTriangulationsEnumerator::DecomposedTriangulationsEnumerator(
+			const Graph& g, const vector<NodeSet>& allPieces,
+			TriangulationScoringCriterion triC, SeparatorsScoringCriterion sepC,
+			TriangulationAlgorithm heuristic, int separatorThreads, int maxWidth,
+			size_t cacheBytes, int extensionThreads, int enumerationThreads,
+			const string& externalDirectory, int extensionCacheSize) :
+		graph(g), numberOfCliquePieces(0), isStarted(false), isFinished(false),
+		nextReady(false) {
+	int numberOfPieces = 0;
+	for (const NodeSet& piece : allPieces) {
+		if (!GraphDecomposer::isClique(graph, piece)) {
+			numberOfPieces++;
+		}
+	}
+	for (const NodeSet& piece : allPieces) {
+		if (GraphDecomposer::isClique(graph, piece)) {
+			numberOfCliquePieces++;
+			// A clique is a bag of every triangulation
+			if (maxWidth >= 0 && (int)piece.size() - 1 > maxWidth) {
+				isFinished = true;
+			}
+			continue;
+		}
+		pieces.push_back(piece);
+		enumerators.push_back(new MinimalTriangulationsEnumerator(
+				GraphDecomposer::getInducedSubgraph(graph, piece), triC, sepC, heuristic,
+				separatorThreads, maxWidth, cacheBytes / numberOfPieces, extensionThreads,
+				enumerationThreads, externalDirectory,
+				extensionCacheSize > 0 ? max(1, extensionCacheSize / numberOfPieces) : 0));
+	}
+	pieceResults.resize(pieces.size());
+	currentResults.resize(pieces.size(), 0);
+}
+
+DecomposedTriangulationsEnumerator::~DecomposedTriangulationsEnumerator() {
+	for (unsigned int i = 0; i < enumerators.size(); i++) {
+		delete enumerators[i];
+	}
+}
+
+bool DecomposedTriangulationsEnumerator::generatePieceResult(int piece) {
+	if (!enumerators[piece]->hasNext()) {
+		return false;
+	}
+	ChordalGraph triangulation = enumerators[piece]->next();
+	const NodeSet& nodes = pieces[piece];
+	FillEdges fillEdges;
+	for (Node v = 0; v < triangulation.getNumberOfNodes(); v++) {
+		for (Node u : triangulation.getNeighbors(v)) {
+			if (v < u && !graph.areNeighbors(nodes[v], nodes[u])) {
+				fillEdges.push_back(make_pair(nodes[v], nodes[u]));
+			}
+		}
+	}
+	if (piece == (int)pieces.size()-1) {
+		pieceResults[piece].clear();
+	}
+	pieceResults[piece].push_back(fillEdges);
+	return true;
+}
+
+/*
+ * Moves the first piece to its next triangulation. When a piece runs out of
+ * triangulations, it starts over and the next piece moves instead.
+ */
+bool DecomposedTriangulationsEnumerator::advance() {
+	for (unsigned int i = 0; i < pieces.size(); i++) {
+		if (i+1 < pieces.size() && currentResults[i]+1 < pieceResults[i].size()) {
+			currentResults[i]++;
+			return true;
+		}
+		if (generatePieceResult(i)) {
+			currentResults[i] = pieceResults[i].size()-1;
+			return true;
+		}
+		currentResults[i] = 0;
+	}
+	return false;
+}
+
+/*
+ * Checks whether there is another minimal triangulation
+ */
+bool DecomposedTriangulationsEnumerator::hasNext() {
+	if (nextReady) {
+		return true;
+	}
+	if (isFinished) {
+		return false;
+	}
+	if (!isStarted) {
+		isStarted = true;
+		for (unsigned int i = 0; i < pieces.size(); i++) {
+			if (!generatePieceResult(i)) {
+				isFinished = true;
+				return false;
+			}
+		}
+		nextReady = true;
+		return true;
+	}
+	nextReady = advance();
+	// A piece whose sets could not be read stops the whole enumeration
+	isFinished = !nextReady || !isValid();
+	nextReady = nextReady && !isFinished;
+	return nextReady;
+}
+
+/*
+ * Returns another minimal triangulation
+ */
+ChordalGraph DecomposedTriangulationsEnumerator::next() {
+	ChordalGraph triangulation(graph);
+	if (!hasNext()) {
+		return triangulation;
+	}
+	nextReady = false;
+	for (unsigned int i = 0; i < pieces.size(); i++) {
+		const FillEdges& fillEdges = pieceResults[i][currentResults[i]];
+		for (FillEdges::const_iterator it = fillEdges.begin(); it != fillEdges.end(); ++it) {
+			triangulation.addEdge(it->first, it->second);
+		}
+	}
+	return triangulation;
+}
+
+int DecomposedTriangulationsEnumerator::getNumberOfMinimalSeperatorsGenerated() {
+	int result = 0;
+	for (unsigned int i = 0; i < enumerators.size(); i++) {
+		result += enumerators[i]->getNumberOfMinimalSeperatorsGenerated();
+	}
+	return result;
+}
+
+long long DecomposedTriangulationsEnumerator::getNumberOfCacheHits() const {
+	long long result = 0;
+	for (unsigned int i = 0; i < enumerators.size(); i++) {
+		result += enumerators[i]->getNumberOfCacheHits();
+	}
+	return result;
+}
+
+long long DecomposedTriangulationsEnumerator::getNumberOfCacheMisses() const {
+	long long result = 0;
+	for (unsigned int i = 0; i < enumerators.size(); i++) {
+		result += enumerators[i]->getNumberOfCacheMisses();
+	}
+	return result;
+}
+
+long long DecomposedTriangulationsEnumerator::getNumberOfExtensionCacheHits() const {
+	long long result = 0;
+	for (unsigned int i = 0; i < enumerators.size(); i++) {
+		result += enumerators[i]->getNumberOfExtensionCacheHits();
+	}
+	return result;
+}
+
+long long DecomposedTriangulationsEnumerator::getNumberOfExtensionCacheMisses() const {
+	long long result = 0;
+	for (unsigned int i = 0; i < enumerators.size(); i++) {
+		result += enumerators[i]->getNumberOfExtensionCacheMisses();
+	}
+	return result;
+}
+
+long long DecomposedTriangulationsEnumerator::getNumberOfSkippedExtensions() const {
+	long long result = 0;
+	for (unsigned int i = 0; i < enumerators.size(); i++) {
+		result += enumerators[i]->getNumberOfSkippedExtensions();
+	}
+	return result;
+}
+
+bool DecomposedTriangulationsEnumerator::isValid() const {
+	for (unsigned int i = 0; i < enumerators.size(); i++) {
+		if (!enumerators[i]->isValid()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+vector<long long> DecomposedTriangulationsEnumerator::countPieceTriangulations() {
+	vector<long long> counts;
+	if (isFinished) {
+		return vector<long long>(enumerators.size(), 0);
+	}
+	for (unsigned int i = 0; i < enumerators.size(); i++) {
+		long long count = 0;
+		while (enumerators[i]->hasNext()) {
+			enumerators[i]->next();
+			count++;
+		}
+		counts.push_back(count);
+	}
+	return counts;
+}
+
+const vector<NodeSet>& DecomposedTriangulationsEnumerator::getPieces() const {
+	return pieces;
+}
+
+int DecomposedTriangulationsEnumerator::getNumberOfCliquePieces() const {
+	return numberOfCliquePieces;
+}
+
+} /* namespace tdenum */
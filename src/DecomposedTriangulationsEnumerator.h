@@ -0,0 +1,85 @@
+#ifndef DECOMPOSEDTRIANGULATIONSENUMERATOR_H_
+#define DECOMPOSEDTRIANGULATIONSENUMERATOR_H_
+
+#include "MinimalTriangulationsEnumerator.h"
+#include <utility>
+
+namespace tdenum {
+
+/**
+ * Enumerates the minimal triangulations of a graph given its decomposition
+ * into pieces, such as the atoms returned by GraphDecomposer.
+ * The minimal triangulations of every piece are enumerated separately, and
+ * the results are the combinations of one triangulation of every piece.
+ * The combinations are generated lazily, like an odometer: the triangulations
+ * of the first piece change fastest, and triangulations of a piece are only
+ * generated when they are needed.
+ */
+class DecomposedTriangulationsEnumerator {
+	typedef vector< pair<Node,Node> > FillEdges;
+	Graph graph;
+	// The pieces that are not cliques, as only they have fill edges
+	vector<NodeSet> pieces;
+	int numberOfCliquePieces;
+	vector<MinimalTriangulationsEnumerator*> enumerators;
+	// The fill edges of the triangulations generated so far for every
+	// piece, in the nodes of graph. Only the current one is kept for the
+	// last piece, since it never starts over.
+	vector< vector<FillEdges> > pieceResults;
+	// The index in pieceResults of the current triangulation of every piece
+	vector<unsigned int> currentResults;
+	bool isStarted;
+	bool isFinished;
+	bool nextReady;
+
+	// Generates another triangulation of the piece and adds its fill edges to
+	// pieceResults. Returns false if there are no more.
+	bool generatePieceResult(int piece);
+	// Moves to the next combination. Returns false if there are no more.
+	bool advance();
+
+	DecomposedTriangulationsEnumerator(const DecomposedTriangulationsEnumerator&);
+	DecomposedTriangulationsEnumerator& operator=(const DecomposedTriangulationsEnumerator&);
+public:
+	// initialization, the pieces are given as node sets of g. The width of a
+	// combination is the largest width of its parts, so the bound on the width
+	// is applied to every piece. The memory budget of the components maps cache
+	// and the number of cached extensions are divided between the pieces.
+	DecomposedTriangulationsEnumerator(const Graph& g, const vector<NodeSet>& pieces,
+			TriangulationScoringCriterion triC, SeparatorsScoringCriterion sepC,
+			TriangulationAlgorithm heuristic, int separatorThreads = 1, int maxWidth = -1,
+			size_t cacheBytes = DEFAULT_COMPONENT_MAP_CACHE_BYTES,
+			int extensionThreads = 1, int enumerationThreads = 1,
+			const string& externalDirectory = "",
+			int extensionCacheSize = DEFAULT_EXTENSION_CACHE_ENTRIES);
+	~DecomposedTriangulationsEnumerator();
+	// Checks whether there is another minimal triangulation
+	bool hasNext();
+	// Returns another minimal triangulation
+	ChordalGraph next();
+	// Returns the number of minimal separators generated in all the pieces
+	int getNumberOfMinimalSeperatorsGenerated();
+	// Returns the numbers of hits and misses of the components maps caches of all the pieces
+	long long getNumberOfCacheHits() const;
+	long long getNumberOfCacheMisses() const;
+	// Returns the numbers of hits and misses of the extensions caches of all the pieces
+	long long getNumberOfExtensionCacheHits() const;
+	long long getNumberOfExtensionCacheMisses() const;
+	// Returns the number of extensions skipped in all the pieces
+	long long getNumberOfSkippedExtensions() const;
+	// Returns whether the files of the sets of all the pieces could be used so far
+	bool isValid() const;
+	// Enumerates all the minimal triangulations of every piece that is not a
+	// clique, and returns their numbers. The other pieces have one each, or
+	// none if they are wider than the bound, and then all the numbers are 0.
+	// Used instead of hasNext and next, not after them.
+	vector<long long> countPieceTriangulations();
+	// Returns the pieces that are not cliques
+	const vector<NodeSet>& getPieces() const;
+	// Returns the number of pieces that are cliques
+	int getNumberOfCliquePieces() const;
+};
+
+} /* namespace tdenum */
+
+#endif /* DECOMPOSEDTRIANGULATIONSENUMERATOR_H_ */
@@ -0,0 +1,315 @@
+#include "DenseGraph.h"
+#include "CompactGraph.h"
+#include "DataStructures.h"
+#include "NodeBitset.h"
+#include <algorithm>
+#include <iostream>
+
+namespace tdenum {
+
+namespace {
+
+const int BITS_PER_WORD = 64;
+
+inline bool testBit(const uint64_t* words, Node v) {
+	return (words[v / BITS_PER_WORD] >> (v % BITS_PER_WORD)) & 1;
+}
+
+inline void setBit(uint64_t* words, Node v) {
+	words[v / BITS_PER_WORD] |= (uint64_t)1 << (v % BITS_PER_WORD);
+}
+
+inline void clearBit(uint64_t* words, Node v) {
+	words[v / BITS_PER_WORD] &= ~((uint64_t)1 << (v % BITS_PER_WORD));
+}
+
+// Appends the nodes whose bits are set in the word, where bit 0 is firstNode
+inline void appendNodes(uint64_t word, Node firstNode, NodeSet& result) {
+	while (word) {
+		result.push_back(firstNode + __builtin_ctzll(word));
+		word &= word - 1;
+	}
+}
+
+} /* anonymous namespace */
+
+DenseGraph::DenseGraph() : numberOfNodes(0), numberOfEdges(0), wordsPerRow(0), offsets(1, 0) {}
+
+DenseGraph::DenseGraph(const Graph& g) {
+	copyNeighbors(g);
+}
+
+DenseGraph::DenseGraph(const CompactGraph& g) {
+	copyNeighbors(g);
+}
+
+template<class G>
+void DenseGraph::copyNeighbors(const G& g) {
+	numberOfNodes = g.getNumberOfNodes();
+	numberOfEdges = g.getNumberOfEdges();
+	wordsPerRow = (numberOfNodes + BITS_PER_WORD - 1) / BITS_PER_WORD;
+	rows.assign((size_t)numberOfNodes*wordsPerRow, 0);
+	offsets.assign(numberOfNodes+1, 0);
+	adjacency.reserve(2*numberOfEdges);
+	for (Node v=0; v<numberOfNodes; v++) {
+		uint64_t* row = rows.data() + (size_t)v*wordsPerRow;
+		for (Node u : g.getNeighbors(v)) {
+			setBit(row, u);
+			adjacency.push_back(u);
+		}
+		offsets[v+1] = adjacency.size();
+	}
+}
+
+Graph DenseGraph::toGraph() const {
+	Graph g(numberOfNodes);
+	for (Node v=0; v<numberOfNodes; v++) {
+		for (Node u : getNeighbors(v)) {
+			if (v < u) {
+				g.addEdge(v, u);
+			}
+		}
+	}
+	return g;
+}
+
+/*
+ * A BFS scans the whole row of every node it visits, and a CompactGraph only
+ * its neighbors.
+ */
+bool DenseGraph::isSearchFaster(int numberOfNodes, int numberOfEdges) {
+	int words = (numberOfNodes + BITS_PER_WORD - 1) / BITS_PER_WORD;
+	return numberOfNodes <= MAX_NODES_FOR_DENSE_GRAPH &&
+			(long long)words*numberOfNodes <= 2*(long long)numberOfEdges;
+}
+
+bool DenseGraph::isValidNode(Node v) const {
+	if (v<0 || v>=numberOfNodes) {
+		cout << "Invalid input" << endl;
+		return false;
+	}
+	return true;
+}
+
+set<Node> DenseGraph::getNodes() const {
+	set<Node> nodes;
+	for (Node i=0; i<numberOfNodes; i++) {
+		nodes.insert(nodes.end(), i);
+	}
+	return nodes;
+}
+
+int DenseGraph::getNumberOfEdges() const {
+	return numberOfEdges;
+}
+
+int DenseGraph::getNumberOfNodes() const {
+	return numberOfNodes;
+}
+
+NodeRange DenseGraph::getNeighbors(Node v) const {
+	if (!isValidNode(v)) {
+		cout << "Error: Requesting access to invalid node" << endl;
+		return NodeRange();
+	}
+	const Node* base = adjacency.data();
+	return NodeRange(base + offsets[v], base + offsets[v+1]);
+}
+
+vector<bool> DenseGraph::getNeighborsMap(Node v) const {
+	vector<bool> result(numberOfNodes, false);
+	const uint64_t* row = getRow(v);
+	for (Node u=0; u<numberOfNodes; u++) {
+		result[u] = testBit(row, u);
+	}
+	return result;
+}
+
+/*
+ * Returns the set of neighbors of nodes in the given node set without returning
+ * nodes that are in the input node set
+ */
+NodeSet DenseGraph::getNeighbors(const set<Node>& inputSet) const {
+	NodeSet neighbors;
+	getNeighbors(NodeSet(inputSet.begin(), inputSet.end()), neighbors);
+	return neighbors;
+}
+
+NodeSet DenseGraph::getNeighbors(const vector<Node>& inputSet) const {
+	NodeSet neighbors;
+	getNeighbors(inputSet, neighbors);
+	return neighbors;
+}
+
+/*
+ * The rows of the nodes are united a word at a time, and the result is
+ * already sorted.
+ */
+void DenseGraph::getNeighbors(const vector<Node>& inputSet, NodeSet& neighbors) const {
+	neighbors.clear();
+	for (Node v : inputSet) {
+		if (!isValidNode(v)) {
+			return;
+		}
+	}
+	static thread_local vector<uint64_t> united;
+	united.assign(wordsPerRow, 0);
+	for (Node v : inputSet) {
+		bitsetUnite(united.data(), getRow(v), wordsPerRow);
+	}
+	for (Node v : inputSet) {
+		clearBit(united.data(), v);
+	}
+	bitsetAppendNodes(united.data(), wordsPerRow, neighbors);
+}
+
+bool DenseGraph::areNeighbors(Node u, Node v) const {
+	return testBit(getRow(u), v);
+}
+
+template<class Container>
+void DenseGraph::getComplement(const Container& removedNodes,
+		vector<uint64_t>& unvisited) const {
+	unvisited.assign(wordsPerRow, ~(uint64_t)0);
+	if (numberOfNodes % BITS_PER_WORD != 0) {
+		unvisited[wordsPerRow-1] = ((uint64_t)1 << (numberOfNodes % BITS_PER_WORD)) - 1;
+	}
+	for (Node v : removedNodes) {
+		clearBit(unvisited.data(), v);
+	}
+}
+
+/*
+ * A BFS where the newly reached nodes of every visited node are found by
+ * intersecting its row with the unvisited nodes, a word at a time. The
+ * component doubles as the BFS queue.
+ */
+void DenseGraph::visitComponent(Node v, vector<uint64_t>& unvisited,
+		NodeSet& component) const {
+	component.clear();
+	component.push_back(v);
+	clearBit(unvisited.data(), v);
+	for (unsigned int head = 0; head < component.size(); head++) {
+		const uint64_t* row = getRow(component[head]);
+		for (int w = 0; w < wordsPerRow; w++) {
+			uint64_t reached = row[w] & unvisited[w];
+			if (reached) {
+				unvisited[w] &= ~reached;
+				appendNodes(reached, w*BITS_PER_WORD, component);
+			}
+		}
+	}
+}
+
+/*
+ * Components are ordered by their smallest node, and sorted, as in CompactGraph.
+ */
+void DenseGraph::visitAllComponents(vector<uint64_t>& unvisited,
+		vector<NodeSet>& components) const {
+	unsigned int numberOfComponents = 0;
+	for (int w = 0; w < wordsPerRow; w++) {
+		while (unvisited[w]) {
+			if (numberOfComponents == components.size()) {
+				components.push_back(NodeSet());
+			}
+			NodeSet& component = components[numberOfComponents++];
+			visitComponent(w*BITS_PER_WORD + __builtin_ctzll(unvisited[w]), unvisited, component);
+			sort(component.begin(), component.end());
+		}
+	}
+	components.resize(numberOfComponents);
+}
+
+vector<NodeSet> DenseGraph::getComponents(const set<Node>& removedNodes) const {
+	return getComponents(NodeSet(removedNodes.begin(), removedNodes.end()));
+}
+
+vector<NodeSet> DenseGraph::getComponents(const NodeSet& removedNodes) const {
+	vector<NodeSet> components;
+	getComponents(removedNodes, components);
+	return components;
+}
+
+void DenseGraph::getComponents(const NodeSet& removedNodes, vector<NodeSet>& components) const {
+	for (Node v : removedNodes) {
+		if (!isValidNode(v)) {
+			components.clear();
+			return;
+		}
+	}
+	static thread_local vector<uint64_t> unvisited;
+	getComplement(removedNodes, unvisited);
+	visitAllComponents(unvisited, components);
+}
+
+vector<NodeSet> DenseGraph::getComponents(const NodeBitset& removedNodes) const {
+	vector<NodeSet> components;
+	getComponents(removedNodes, components);
+	return components;
+}
+
+void DenseGraph::getComponents(const NodeBitset& removedNodes, vector<NodeSet>& components) const {
+	static thread_local vector<uint64_t> unvisited;
+	getComplement(NodeSet(), unvisited);
+	bitsetSubtract(unvisited.data(), removedNodes.getWords(), wordsPerRow);
+	visitAllComponents(unvisited, components);
+}
+
+vector<int> DenseGraph::getComponentsMap(const vector<Node>& removedNodes) const {
+	vector<int> componentsMap;
+	getComponentsMap(removedNodes, componentsMap);
+	return componentsMap;
+}
+
+void DenseGraph::getComponentsMap(const vector<Node>& removedNodes,
+		vector<int>& componentsMap) const {
+	getComponentsMap(NodeRange(removedNodes.data(), removedNodes.data() + removedNodes.size()),
+			componentsMap);
+}
+
+/*
+ * The components are numbered from 1 by their smallest node, as in CompactGraph.
+ */
+void DenseGraph::getComponentsMap(NodeRange removedNodes,
+		vector<int>& componentsMap) const {
+	componentsMap.assign(numberOfNodes, -1);
+	for (Node v : removedNodes) {
+		if (!isValidNode(v)) {
+			componentsMap.clear();
+			return;
+		}
+	}
+	static thread_local vector<uint64_t> unvisited;
+	getComplement(removedNodes, unvisited);
+	vector<Node>& component = TraversalWorkspace::get(numberOfNodes).getQueue();
+	int currentComponent = 1;
+	for (int w = 0; w < wordsPerRow; w++) {
+		while (unvisited[w]) {
+			visitComponent(w*BITS_PER_WORD + __builtin_ctzll(unvisited[w]), unvisited, component);
+			for (Node v : component) {
+				componentsMap[v] = currentComponent;
+			}
+			currentComponent++;
+		}
+	}
+}
+
+set<Node> DenseGraph::getComponent(Node v, const set<Node>& removedNodes) const {
+	vector<uint64_t> unvisited;
+	getComplement(removedNodes, unvisited);
+	NodeSet component;
+	visitComponent(v, unvisited, component);
+	return set<Node>(component.begin(), component.end());
+}
+
+void DenseGraph::print() const {
+	for (Node v=0; v<numberOfNodes; v++) {
+		cout << v << " has neighbors: {";
+		for (Node u : getNeighbors(v)) {
+			cout << u << " ";
+		}
+		cout << "}" << endl;
+	}
+}
+
+} /* namespace tdenum */
@@ -0,0 +1,111 @@
+#ifndef DENSEGRAPH_H_
+#define DENSEGRAPH_H_
+
+#include "Graph.h"
+#include <stdint.h>
+
+namespace tdenum {
+
+class CompactGraph;
+class NodeBitset;
+
+// The largest graphs kept as a DenseGraph, whose rows then take 2 MB
+const int MAX_NODES_FOR_DENSE_GRAPH = 4096;
+
+/**
+ * An immutable graph stored as an adjacency matrix with one bit per node pair,
+ * along with the sorted neighbor lists of CompactGraph. Provides the read API
+ * of CompactGraph, where neighbor tests are a single bit lookup and searches
+ * handle 64 nodes per word. Uses n^2/8 bytes, so it is meant for graphs of up
+ * to a few thousand nodes.
+ */
+class DenseGraph {
+	int numberOfNodes;
+	int numberOfEdges;
+	int wordsPerRow;
+	// The neighbors of v are the bits set in rows[v*wordsPerRow] ... rows[(v+1)*wordsPerRow-1]
+	vector<uint64_t> rows;
+	// The neighbors of v are adjacency[offsets[v]] ... adjacency[offsets[v+1]-1]
+	vector<int> offsets;
+	vector<Node> adjacency;
+
+	bool isValidNode(Node v) const;
+	// Copies the neighbors of every node of the given graph
+	template<class G>
+	void copyNeighbors(const G& g);
+	// Stores in unvisited the nodes not in the given set
+	template<class Container>
+	void getComplement(const Container& removedNodes, vector<uint64_t>& unvisited) const;
+	// Removes from unvisited the nodes reachable from v, including v, and
+	// stores them in component
+	void visitComponent(Node v, vector<uint64_t>& unvisited, NodeSet& component) const;
+	// Stores in components the components of the unvisited nodes, reusing the
+	// buffers it already holds
+	void visitAllComponents(vector<uint64_t>& unvisited, vector<NodeSet>& components) const;
+
+public:
+	// Constructs an empty graph
+	DenseGraph();
+	// Constructs a dense copy of the given graph
+	DenseGraph(const Graph& g);
+	// Constructs a dense copy of the given graph
+	DenseGraph(const CompactGraph& g);
+	// Returns a modifiable copy of this graph
+	Graph toGraph() const;
+	// Returns whether searches in a DenseGraph of a graph with the given
+	// numbers of nodes and edges are expected to be faster than in a
+	// CompactGraph: it has at most MAX_NODES_FOR_DENSE_GRAPH nodes, and a row
+	// takes no more words than the average degree
+	static bool isSearchFaster(int numberOfNodes, int numberOfEdges);
+
+	// Returns the nodes of the graph
+	set<Node> getNodes() const;
+	// Returns the number of edges in the graph
+	int getNumberOfEdges() const;
+	// Returns the number of nodes in the graph
+	int getNumberOfNodes() const;
+	// Returns the neighbors of the given node
+	NodeRange getNeighbors(Node v) const;
+	// Returns the neighbors of the given node as a row of getNumberOfWords()
+	// words, where bit u of the row is whether u is a neighbor
+	const uint64_t* getRow(Node v) const { return rows.data() + (size_t)v*wordsPerRow; }
+	int getNumberOfWords() const { return wordsPerRow; }
+	// Returns a vector the size of the number of nodes in the graph, stating
+	// whether the index nodes are neighbors of the input node.
+	vector<bool> getNeighborsMap(Node v) const;
+	// Returns the neighbors of the given node set
+	NodeSet getNeighbors(const vector<Node>& s) const;
+	// Returns the neighbors of the given node set
+	NodeSet getNeighbors(const set<Node>& s) const;
+	// Stores the neighbors of the given node set in neighbors, reusing its buffer
+	void getNeighbors(const vector<Node>& s, NodeSet& neighbors) const;
+	// Returns whether there is an edge between the given two nodes
+	bool areNeighbors(Node u, Node v) const;
+	// Returns a map from the Nodes numbers to the number of the component they are in.
+	// -1 if they are in the input set.
+	vector<int> getComponentsMap(const vector<Node>& removedNodes) const;
+	// Stores the map returned by getComponentsMap in componentsMap, reusing its buffer
+	void getComponentsMap(const vector<Node>& removedNodes, vector<int>& componentsMap) const;
+	void getComponentsMap(NodeRange removedNodes, vector<int>& componentsMap) const;
+	// Returns the set of components obtained by removing the given node set
+	vector<NodeSet> getComponents(const set<Node>& removedNodes) const;
+	// Returns the set of components obtained by removing the given node set
+	vector<NodeSet> getComponents(const NodeSet& removedNodes) const;
+	// Returns the set of components obtained by removing the given node set
+	vector<NodeSet> getComponents(const NodeBitset& removedNodes) const;
+	// Stores the components obtained by removing the given node set in
+	// components, reusing the buffers it already holds
+	void getComponents(const NodeSet& removedNodes, vector<NodeSet>& components) const;
+	// Stores the components obtained by removing the given node set in
+	// components, reusing the buffers it already holds
+	void getComponents(const NodeBitset& removedNodes, vector<NodeSet>& components) const;
+	// Returns all the nodes reachable from the node after removing
+	// the removedNodes from the graph
+	set<Node> getComponent(Node v, const set<Node>& removedNodes) const;
+	// Prints the graph
+	void print() const;
+};
+
+} /* namespace tdenum */
+
+#endif /* DENSEGRAPH_H_ */
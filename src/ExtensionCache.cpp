@@ -0,0 +1,100 @@
+#include "ExtensionCache.h"
+
+namespace tdenum {
+
+ExtensionCache::ExtensionCache(int numberOfEntries) : numberOfEntries(0), hits(0), misses(0) {
+	if (numberOfEntries > 0) {
+		this->numberOfEntries = 1;
+		while (this->numberOfEntries < (size_t)numberOfEntries) {
+			this->numberOfEntries *= 2;
+		}
+	}
+}
+
+int ExtensionCache::find(uint64_t firstHash, uint64_t secondHash) {
+	if (entries.empty()) {
+		if (isEnabled()) {
+			misses++;
+		}
+		return -1;
+	}
+	const Entry& entry = entries[firstHash & (entries.size() - 1)];
+	if (entry.handle != -1 && entry.firstHash == firstHash && entry.secondHash == secondHash) {
+		hits++;
+		return entry.handle;
+	}
+	misses++;
+	return -1;
+}
+
+/*
+ * The entries are allocated by the first insertion, so enumerators that never
+ * repeat an extension do not pay for them.
+ */
+void ExtensionCache::insert(uint64_t firstHash, uint64_t secondHash, int handle) {
+	if (!isEnabled()) {
+		return;
+	}
+	if (entries.empty()) {
+		Entry empty = {0, 0, -1};
+		entries.assign(numberOfEntries, empty);
+	}
+	Entry entry = {firstHash, secondHash, handle};
+	entries[firstHash & (entries.size() - 1)] = entry;
+}
+
+bool ExtensionCache::isEnabled() const {
+	return numberOfEntries > 0;
+}
+
+long long ExtensionCache::getNumberOfHits() const {
+	return hits;
+}
+
+long long ExtensionCache::getNumberOfMisses() const {
+	return misses;
+}
+
+/*
+ * Only the entries in use are written, with their positions.
+ */
+void ExtensionCache::save(CheckpointWriter& output) const {
+	output.writeNumber(hits);
+	output.writeNumber(misses);
+	output.writeNumber(numberOfEntries);
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (entries[i].handle != -1) {
+			output.writeNumber(i + 1);
+			output.writeNumber(entries[i].firstHash);
+			output.writeNumber(entries[i].secondHash);
+			output.writeNumber(entries[i].handle);
+		}
+	}
+	output.writeNumber(0);
+}
+
+void ExtensionCache::load(CheckpointReader& input) {
+	hits = input.readNumber();
+	misses = input.readNumber();
+	if (input.readNumber() != numberOfEntries) {
+		input.fail();
+		return;
+	}
+	entries.clear();
+	for (uint64_t i = input.readNumber(); i != 0 && input.isValid(); i = input.readNumber()) {
+		if (i > numberOfEntries) {
+			input.fail();
+			return;
+		}
+		if (entries.empty()) {
+			Entry empty = {0, 0, -1};
+			entries.assign(numberOfEntries, empty);
+		}
+		Entry& entry = entries[i - 1];
+		entry.firstHash = input.readNumber();
+		entry.secondHash = input.readNumber();
+		entry.handle = input.readNumber();
+	}
+}
+
+} /* namespace tdenum */
@@ -0,0 +1,53 @@
+#ifndef EXTENSIONCACHE_H_
+#define EXTENSIONCACHE_H_
+
+#include "Checkpoint.h"
+#include <vector>
+#include <stdint.h>
+using namespace std;
+
+namespace tdenum {
+
+// The default number of entries of an ExtensionCache
+const int DEFAULT_EXTENSION_CACHE_ENTRIES = 1 << 16;
+
+/**
+ * Remembers the maximal independent sets that recent base sets were extended
+ * to, within a fixed number of entries. A base set is identified by two
+ * independent 64 bit hashes, and its extension by its handle in the store of
+ * the sets found. Every base set has a single entry it may be kept in, chosen
+ * by its first hash, and a new base set replaces the one kept there.
+ */
+class ExtensionCache {
+	struct Entry {
+		uint64_t firstHash;
+		uint64_t secondHash;
+		// The handle of the extension, or -1 if the entry is empty
+		int handle;
+	};
+	// The number of entries, and the entries, allocated when first used
+	size_t numberOfEntries;
+	vector<Entry> entries;
+	long long hits;
+	long long misses;
+public:
+	// Initialization with at least the given number of entries, rounded up to
+	// a power of 2. 0 disables the cache.
+	ExtensionCache(int numberOfEntries = DEFAULT_EXTENSION_CACHE_ENTRIES);
+	// Returns the handle of the extension of the base set with the given
+	// hashes, or -1 if it is not kept. Counts a hit or a miss.
+	int find(uint64_t firstHash, uint64_t secondHash);
+	// Keeps the handle of the extension of the base set with the given hashes
+	void insert(uint64_t firstHash, uint64_t secondHash, int handle);
+	// Returns whether the cache has any entries
+	bool isEnabled() const;
+	long long getNumberOfHits() const;
+	long long getNumberOfMisses() const;
+	// Writes and restores the entries and the statistics
+	void save(CheckpointWriter& output) const;
+	void load(CheckpointReader& input);
+};
+
+} /* namespace tdenum */
+
+#endif /* EXTENSIONCACHE_H_ */
@@ -1,6 +1,6 @@
 #include "Graph.h"
 #include "DataStructures.h"
-#include <queue>
+#include <algorithm>
 #include <iostream>
 
 namespace tdenum {
@@ -114,37 +114,40 @@ vector<bool> Graph::getNeighborsMap(Node v) const {
  * nodes that are in the input node set
  */
 NodeSet Graph::getNeighbors(const set<Node>& inputSet) const {
-	NodeSetProducer neighborsProducer(numberOfNodes);
-	for (set<Node>::const_iterator i = inputSet.begin(); i != inputSet.end(); ++i) {
-		Node v = *i;
-		if (!isValidNode(v)) {
-			return NodeSet();
-		}
-		for (set<Node>::iterator j = neighborSets[v].begin(); j != neighborSets[v].end(); ++j) {
-			neighborsProducer.insert(*j);
-		}
-	}
-	for (set<Node>::const_iterator i = inputSet.begin(); i != inputSet.end(); ++i) {
-		neighborsProducer.remove(*i);
-	}
-	return neighborsProducer.produce();
+	NodeSet neighbors;
+	getNeighbors(NodeSet(inputSet.begin(), inputSet.end()), neighbors);
+	return neighbors;
 }
 
 NodeSet Graph::getNeighbors(const vector<Node>& inputSet) const {
-	NodeSetProducer neighborsProducer(numberOfNodes);
+	NodeSet neighbors;
+	getNeighbors(inputSet, neighbors);
+	return neighbors;
+}
+
+/*
+ * Marks the input set in the workspace, so every neighbor is collected once
+ * and only the neighbors found have to be sorted.
+ */
+void Graph::getNeighbors(const vector<Node>& inputSet, NodeSet& neighbors) const {
+	neighbors.clear();
 	for (vector<Node>::const_iterator i = inputSet.begin(); i != inputSet.end(); ++i) {
-		Node v = *i;
-		if (!isValidNode(v)) {
-			return NodeSet();
-		}
-		for (set<Node>::iterator j = neighborSets[v].begin(); j != neighborSets[v].end(); ++j) {
-			neighborsProducer.insert(*j);
+		if (!isValidNode(*i)) {
+			return;
 		}
 	}
+	TraversalWorkspace& workspace = TraversalWorkspace::get(numberOfNodes);
 	for (vector<Node>::const_iterator i = inputSet.begin(); i != inputSet.end(); ++i) {
-		neighborsProducer.remove(*i);
+		workspace.mark(*i);
+	}
+	for (vector<Node>::const_iterator i = inputSet.begin(); i != inputSet.end(); ++i) {
+		for (set<Node>::iterator j = neighborSets[*i].begin(); j != neighborSets[*i].end(); ++j) {
+			if (workspace.markIfNew(*j)) {
+				neighbors.push_back(*j);
+			}
+		}
 	}
-	return neighborsProducer.produce();
+	sort(neighbors.begin(), neighbors.end());
 }
 
 bool Graph::areNeighbors(Node u, Node v) const {
@@ -152,137 +155,137 @@ bool Graph::areNeighbors(Node u, Node v) const {
 }
 
 vector<NodeSet> Graph::getComponents(const set<Node>& removedNodes) const {
-	vector<int> visitedList(numberOfNodes, 0);
+	vector<NodeSet> components;
 	for (set<Node>::iterator i = removedNodes.begin(); i != removedNodes.end(); ++i) {
-		Node v = *i;
-		if (!isValidNode(v)) {
-			return vector<NodeSet>();
+		if (!isValidNode(*i)) {
+			return components;
 		}
-		visitedList[v] = -1;
 	}
-	int numberOfUnhandeledNodes = numberOfNodes - removedNodes.size();
-	return getComponentsAux(visitedList, numberOfUnhandeledNodes);
+	TraversalWorkspace& workspace = TraversalWorkspace::get(numberOfNodes);
+	for (set<Node>::iterator i = removedNodes.begin(); i != removedNodes.end(); ++i) {
+		workspace.mark(*i);
+	}
+	collectComponents(workspace, numberOfNodes - removedNodes.size(), components);
+	return components;
 }
 
 vector<NodeSet> Graph::getComponents(const NodeSet& removedNodes) const {
-	vector<int> visitedList(numberOfNodes, 0);
+	vector<NodeSet> components;
+	getComponents(removedNodes, components);
+	return components;
+}
+
+void Graph::getComponents(const NodeSet& removedNodes, vector<NodeSet>& components) const {
 	for (Node v : removedNodes) {
 		if (!isValidNode(v)) {
-			return vector<NodeSet>();
+			components.clear();
+			return;
 		}
-		visitedList[v] = -1;
 	}
-	int numberOfUnhandeledNodes = numberOfNodes - removedNodes.size();
-	return getComponentsAux(visitedList, numberOfUnhandeledNodes);
+	TraversalWorkspace& workspace = TraversalWorkspace::get(numberOfNodes);
+	for (Node v : removedNodes) {
+		workspace.mark(v);
+	}
+	collectComponents(workspace, numberOfNodes - removedNodes.size(), components);
 }
 
-vector<NodeSet> Graph::getComponentsAux(vector<int> visitedList, int numberOfUnhandeledNodes) const {
-	vector<NodeSet> components;
+/*
+ * Each component is found by a BFS that appends its members to the component
+ * itself, which doubles as the BFS queue. Components are ordered by their
+ * smallest node, and sorted at the end.
+ */
+void Graph::collectComponents(TraversalWorkspace& workspace, int numberOfUnhandeledNodes,
+		vector<NodeSet>& components) const {
+	unsigned int numberOfComponents = 0;
 	// Finds a new component in each iteration
-	while (numberOfUnhandeledNodes > 0) {
-		queue<Node> bfsQueue;
-		NodeSetProducer componentProducer(visitedList.size());
-		// Initialize the queue to contain a node not handled
-		for (Node i=0; i<numberOfNodes; i++) {
-			if (visitedList[i]==0) {
-				bfsQueue.push(i);
-				visitedList[i]=1;
-				componentProducer.insert(i);
-				numberOfUnhandeledNodes--;
-				break;
-			}
+	for (Node start = 0; start < numberOfNodes && numberOfUnhandeledNodes > 0; start++) {
+		if (!workspace.markIfNew(start)) {
+			continue;
+		}
+		if (numberOfComponents == components.size()) {
+			components.push_back(NodeSet());
 		}
+		NodeSet& component = components[numberOfComponents++];
+		component.clear();
+		component.push_back(start);
 		// BFS through the component
-		while (!bfsQueue.empty()) {
-			Node v = bfsQueue.front();
-			bfsQueue.pop();
-			for (set<Node>::iterator i = neighborSets[v].begin();
-					i != neighborSets[v].end(); ++i) {
-				Node u = *i;
-				if (visitedList[u]==0) {
-					bfsQueue.push(u);
-					visitedList[u]=1;
-					componentProducer.insert(u);
-					numberOfUnhandeledNodes--;
+		for (unsigned int head = 0; head < component.size(); head++) {
+			const set<Node>& neighbors = neighborSets[component[head]];
+			for (set<Node>::iterator i = neighbors.begin(); i != neighbors.end(); ++i) {
+				if (workspace.markIfNew(*i)) {
+					component.push_back(*i);
 				}
 			}
 		}
-		components.push_back(componentProducer.produce());
+		numberOfUnhandeledNodes -= component.size();
+		sort(component.begin(), component.end());
 	}
-	return components;
+	components.resize(numberOfComponents);
 }
 
 vector<int> Graph::getComponentsMap(const vector<Node>& removedNodes) const {
-	vector<int> visitedList(numberOfNodes, 0);
+	vector<int> componentsMap;
+	getComponentsMap(removedNodes, componentsMap);
+	return componentsMap;
+}
+
+void Graph::getComponentsMap(const vector<Node>& removedNodes, vector<int>& componentsMap) const {
+	componentsMap.assign(numberOfNodes, 0);
 	for (vector<Node>::const_iterator i = removedNodes.begin(); i != removedNodes.end(); ++i) {
 		Node v = *i;
 		if (!isValidNode(v)) {
-			return vector<int>();
+			componentsMap.clear();
+			return;
 		}
-		visitedList[v] = -1;
+		componentsMap[v] = -1;
 	}
-	int numberOfUnhandeledNodes = numberOfNodes - removedNodes.size();
+	vector<Node>& bfsQueue = TraversalWorkspace::get(numberOfNodes).getQueue();
 	int currentComponent = 1;
-	while (numberOfUnhandeledNodes > 0) {
-			queue<Node> bfsQueue;
-			// Initialize the queue to contain a node not handled
-			for (Node i=0; i<numberOfNodes; i++) {
-				if (visitedList[i]==0) {
-					bfsQueue.push(i);
-					visitedList[i]=currentComponent;
-					numberOfUnhandeledNodes--;
-					break;
-				}
-			}
-			// BFS through the component
-			while (!bfsQueue.empty()) {
-				Node v = bfsQueue.front();
-				bfsQueue.pop();
-				for (set<Node>::iterator i = neighborSets[v].begin();
-						i != neighborSets[v].end(); ++i) {
-					Node u = *i;
-					if (visitedList[u]==0) {
-						bfsQueue.push(u);
-						visitedList[u]=currentComponent;
-						numberOfUnhandeledNodes--;
-					}
+	for (Node start = 0; start < numberOfNodes; start++) {
+		if (componentsMap[start] != 0) {
+			continue;
+		}
+		// BFS through the component
+		bfsQueue.clear();
+		bfsQueue.push_back(start);
+		componentsMap[start] = currentComponent;
+		for (unsigned int head = 0; head < bfsQueue.size(); head++) {
+			const set<Node>& neighbors = neighborSets[bfsQueue[head]];
+			for (set<Node>::iterator i = neighbors.begin(); i != neighbors.end(); ++i) {
+				if (componentsMap[*i] == 0) {
+					componentsMap[*i] = currentComponent;
+					bfsQueue.push_back(*i);
 				}
 			}
-			currentComponent++;
 		}
-	return visitedList;
+		currentComponent++;
+	}
 }
 
 // Returns the nodes reachable from v after removing removedNodes.
 // Uses a BFS from v, where nodes in removedNodes are not processed.
 set<Node> Graph::getComponent(Node v, const set<Node>& removedNodes) {
-	queue<Node> q;
-	vector<bool> insertedNodes = vector<bool>(numberOfNodes);
-	set<Node> component;
+	TraversalWorkspace& workspace = TraversalWorkspace::get(numberOfNodes);
+	vector<Node>& q = workspace.getQueue();
 
 	// Mark removedNodes as inserted to avoid processing them
 	for (Node removed : removedNodes) {
-		insertedNodes[removed] = true;
+		workspace.mark(removed);
 	}
 
 	// Initialize the BFS with v
-	component.insert(v);
-	q.push(v);
-	insertedNodes[v] = true;
+	q.push_back(v);
+	workspace.mark(v);
 	// BFS through the component
-	while (!q.empty()) {
-		v = q.front();
-		q.pop();
-		const set<Node>& neighbors = getNeighbors(v);
+	for (unsigned int head = 0; head < q.size(); head++) {
+		const set<Node>& neighbors = getNeighbors(q[head]);
 		for (Node neighbor : neighbors) {
-			if (!insertedNodes[neighbor]) {
-				q.push(neighbor);
-				insertedNodes[neighbor] = true;
-				component.insert(neighbor);
+			if (workspace.markIfNew(neighbor)) {
+				q.push_back(neighbor);
 			}
 		}
 	}
-	return component;
+	return set<Node>(q.begin(), q.end());
 }
 
 void Graph::print() const {
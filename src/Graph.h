@@ -12,13 +12,33 @@ typedef int Node;
 typedef vector<Node> NodeSet; // sorted vector of node names
 typedef NodeSet MinimalSeparator;
 
+class TraversalWorkspace;
+
+/*
+ * A read-only view of a contiguous range of nodes, sorted ascending.
+ */
+class NodeRange {
+	const Node* first;
+	const Node* last;
+public:
+	NodeRange() : first(NULL), last(NULL) {}
+	NodeRange(const Node* first, const Node* last) : first(first), last(last) {}
+	const Node* begin() const { return first; }
+	const Node* end() const { return last; }
+	int size() const { return last - first; }
+	bool empty() const { return first == last; }
+};
+
 class Graph {
 	int numberOfNodes;
 	int numberOfEdges;
 	vector< set<Node> > neighborSets;
 
 	bool isValidNode(Node v) const;
-	vector< vector<Node> > getComponentsAux(vector<int> visitedList, int numberOfUnhandeledNodes) const;
+	// Stores in components the components of the nodes not marked in the
+	// workspace, given how many such nodes there are
+	void collectComponents(TraversalWorkspace& workspace, int numberOfUnhandeledNodes,
+			vector<NodeSet>& components) const;
 
 public:
 	// Constructs an empty graph
@@ -51,15 +71,22 @@ public:
 	NodeSet getNeighbors(const vector<Node>& s) const;
 	// Returns the neighbors of the given node set
 	NodeSet getNeighbors(const set<Node>& s) const;
+	// Stores the neighbors of the given node set in neighbors, reusing its buffer
+	void getNeighbors(const vector<Node>& s, NodeSet& neighbors) const;
 	// Returns whether there is an edge between the given two nodes
 	bool areNeighbors(Node u, Node v) const;
 	// Returns a map from the Nodes numbers to the number of the component they are in.
 	// -1 if they are in the input set.
 	vector<int> getComponentsMap(const vector<Node>& removedNodes) const;
+	// Stores the map returned by getComponentsMap in componentsMap, reusing its buffer
+	void getComponentsMap(const vector<Node>& removedNodes, vector<int>& componentsMap) const;
 	// Returns the set of components obtained by removing the given node set
 	vector<NodeSet> getComponents(const set<Node>& removedNodes) const;
 	// Returns the set of components obtained by removing the given node set
 	vector<NodeSet> getComponents(const NodeSet& removedNodes) const;
+	// Stores the components obtained by removing the given node set in
+	// components, reusing the buffers it already holds
+	void getComponents(const NodeSet& removedNodes, vector<NodeSet>& components) const;
 	// Returns all the nodes reachable from the node after removing
 	// the removedNodes from the graph
 	set<Node> getComponent(Node v, const set<Node>& removedNodes);
@@ -0,0 +1,111 @@
+#include "GraphDecomposer.h"
+#include "Converter.h"
+#include "DataStructures.h"
+#include "MinimalTriangulator.h"
+#include "NodeBitset.h"
+#include <algorithm>
+
+namespace tdenum {
+
+/*
+ * The pieces are the components of the piece without the separator, each
+ * with its neighbors in the separator.
+ */
+vector<NodeSet> GraphDecomposer::splitByCliqueSeparator(const Graph& g,
+		const NodeSet& piece, const NodeSet& separator) {
+	vector<NodeSet> pieces;
+	NodeBitset inPiece(g.getNumberOfNodes(), piece);
+	NodeBitset inSeparator(g.getNumberOfNodes(), separator);
+	TraversalWorkspace& workspace = TraversalWorkspace::get(g.getNumberOfNodes());
+	for (Node v : separator) {
+		workspace.mark(v);
+	}
+	NodeBitset separatorNeighbors(g.getNumberOfNodes());
+	for (Node start : piece) {
+		if (!workspace.markIfNew(start)) {
+			continue;
+		}
+		NodeSet component;
+		component.push_back(start);
+		separatorNeighbors.clear();
+		for (unsigned int head = 0; head < component.size(); head++) {
+			for (Node u : g.getNeighbors(component[head])) {
+				if (inSeparator.contains(u)) {
+					separatorNeighbors.insert(u);
+				} else if (inPiece.contains(u) && workspace.markIfNew(u)) {
+					component.push_back(u);
+				}
+			}
+		}
+		NodeSet neighbors = separatorNeighbors.toNodeSet();
+		component.insert(component.end(), neighbors.begin(), neighbors.end());
+		sort(component.begin(), component.end());
+		pieces.push_back(component);
+	}
+	if (pieces.size() <= 1) {
+		return vector<NodeSet>(1, piece);
+	}
+	return pieces;
+}
+
+/*
+ * Starts from the connected components, and splits every piece that
+ * contains a clique minimal separator by it. Clique separators do not cross,
+ * so the order of the splits does not matter.
+ */
+vector<NodeSet> GraphDecomposer::getAtoms(const Graph& g) {
+	vector<NodeSet> atoms = getConnectedComponents(g);
+	MinimalTriangulator triangulator(MCS_M);
+	set<MinimalSeparator> separators =
+			Converter::triangulationToMinimalSeparators(triangulator.triangulate(g));
+	for (const MinimalSeparator& separator : separators) {
+		if (!isClique(g, separator)) {
+			continue;
+		}
+		vector<NodeSet> splitAtoms;
+		for (const NodeSet& atom : atoms) {
+			if (!includes(atom.begin(), atom.end(), separator.begin(), separator.end())) {
+				splitAtoms.push_back(atom);
+				continue;
+			}
+			vector<NodeSet> pieces = splitByCliqueSeparator(g, atom, separator);
+			splitAtoms.insert(splitAtoms.end(), pieces.begin(), pieces.end());
+		}
+		atoms.swap(splitAtoms);
+	}
+	sort(atoms.begin(), atoms.end());
+	return atoms;
+}
+
+vector<NodeSet> GraphDecomposer::getConnectedComponents(const Graph& g) {
+	return g.getComponents(NodeSet());
+}
+
+Graph GraphDecomposer::getInducedSubgraph(const Graph& g, const NodeSet& nodes) {
+	Graph subgraph(nodes.size());
+	vector<int> indexInSubgraph(g.getNumberOfNodes(), -1);
+	for (unsigned int i = 0; i < nodes.size(); i++) {
+		indexInSubgraph[nodes[i]] = i;
+	}
+	for (unsigned int i = 0; i < nodes.size(); i++) {
+		for (Node u : g.getNeighbors(nodes[i])) {
+			if (indexInSubgraph[u] > (int)i) {
+				subgraph.addEdge(i, indexInSubgraph[u]);
+			}
+		}
+	}
+	return subgraph;
+}
+
+bool GraphDecomposer::isClique(const Graph& g, const NodeSet& nodes) {
+	for (unsigned int i = 0; i < nodes.size(); i++) {
+		for (unsigned int j = i+1; j < nodes.size(); j++) {
+			if (!g.areNeighbors(nodes[i], nodes[j])) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+} /* namespace tdenum */
@@ -0,0 +1,41 @@
+#ifndef GRAPHDECOMPOSER_H_
+#define GRAPHDECOMPOSER_H_
+
+#include "Graph.h"
+
+namespace tdenum {
+
+/**
+ * Decomposes a graph into pieces whose minimal triangulations can be
+ * enumerated independently. Every minimal triangulation of the graph is the
+ * union of minimal triangulations of the subgraphs induced by the pieces,
+ * and every such union is a minimal triangulation of the graph.
+ */
+class GraphDecomposer {
+	// Returns the pieces obtained by splitting the given piece by the clique
+	// separator, or only the piece if it is not separated
+	static vector<NodeSet> splitByCliqueSeparator(const Graph& g,
+			const NodeSet& piece, const NodeSet& separator);
+public:
+	/**
+	 * Returns the atoms of the graph, which are the maximal connected
+	 * induced subgraphs that have no clique separator.
+	 *
+	 * The clique minimal separators are found among the minimal separators
+	 * of an MCS-M triangulation, as described in:
+	 * A. Berry, R. Pogorelcnik and G. Simonet. An introduction to clique
+	 * minimal separator decomposition. Algorithms, 3(2): 197-215, 2010.
+	 */
+	static vector<NodeSet> getAtoms(const Graph& g);
+	// Returns the connected components of the graph, ordered by their smallest node
+	static vector<NodeSet> getConnectedComponents(const Graph& g);
+	// Returns the subgraph induced by the given nodes, where node i of the
+	// subgraph is nodes[i]
+	static Graph getInducedSubgraph(const Graph& g, const NodeSet& nodes);
+	// Returns whether the given nodes form a clique
+	static bool isClique(const Graph& g, const NodeSet& nodes);
+};
+
+} /* namespace tdenum */
+
+#endif /* GRAPHDECOMPOSER_H_ */
@@ -5,6 +5,7 @@
 #include <string>
 #include <map>
 #include <utility>
+#include <algorithm>
 
 using namespace std;
 
@@ -219,5 +220,115 @@ pair<Graph,map<int,string> > GraphReader::read(const string& fileName) {
 	return pair<Graph,map<int,string> > ();
 }
 
+pair<Graph,map<int,string> > GraphReader::read(const string& fileName, NodeOrdering ordering) {
+	return reorder(read(fileName), ordering);
+}
+
+/*
+ * Returns the nodes of the graph in Reverse Cuthill-McKee order. Every
+ * component is searched from a node of minimum degree.
+ */
+vector<Node> getReverseCuthillMcKeeOrder(const Graph& g) {
+	int n = g.getNumberOfNodes();
+	vector< pair<int,Node> > nodesByDegree;
+	for (Node v=0; v<n; v++) {
+		nodesByDegree.push_back(make_pair(g.getNeighbors(v).size(), v));
+	}
+	sort(nodesByDegree.begin(), nodesByDegree.end());
+	vector<Node> order;
+	vector<bool> visited(n, false);
+	vector< pair<int,Node> > newNeighbors;
+	for (unsigned int i=0; i<nodesByDegree.size(); i++) {
+		Node start = nodesByDegree[i].second;
+		if (visited[start]) {
+			continue;
+		}
+		visited[start] = true;
+		order.push_back(start);
+		for (unsigned int head=order.size()-1; head<order.size(); head++) {
+			newNeighbors.clear();
+			for (Node u : g.getNeighbors(order[head])) {
+				if (!visited[u]) {
+					visited[u] = true;
+					newNeighbors.push_back(make_pair(g.getNeighbors(u).size(), u));
+				}
+			}
+			sort(newNeighbors.begin(), newNeighbors.end());
+			for (unsigned int j=0; j<newNeighbors.size(); j++) {
+				order.push_back(newNeighbors[j].second);
+			}
+		}
+	}
+	reverse(order.begin(), order.end());
+	return order;
+}
+
+/*
+ * Returns the nodes of the graph in the order of repeatedly removing a node of
+ * minimum degree. Uses buckets of nodes by degree, where a node is added to
+ * a new bucket whenever its degree decreases, and outdated entries are skipped.
+ */
+vector<Node> getDegeneracyOrder(const Graph& g) {
+	int n = g.getNumberOfNodes();
+	vector<int> degree(n);
+	vector< vector<Node> > buckets(n);
+	for (Node v=n-1; v>=0; v--) {
+		degree[v] = g.getNeighbors(v).size();
+		buckets[degree[v]].push_back(v);
+	}
+	vector<Node> order;
+	vector<bool> removed(n, false);
+	int minDegree = 0;
+	while ((int)order.size() < n) {
+		while (buckets[minDegree].empty()) {
+			minDegree++;
+		}
+		Node v = buckets[minDegree].back();
+		buckets[minDegree].pop_back();
+		if (removed[v] || degree[v] != minDegree) {
+			continue;
+		}
+		removed[v] = true;
+		order.push_back(v);
+		for (Node u : g.getNeighbors(v)) {
+			if (!removed[u]) {
+				degree[u]--;
+				buckets[degree[u]].push_back(u);
+				minDegree = min(minDegree, degree[u]);
+			}
+		}
+	}
+	return order;
+}
+
+pair<Graph,map<int,string> > GraphReader::reorder(
+		const pair<Graph,map<int,string> >& graphInfo, NodeOrdering ordering) {
+	const Graph& g = graphInfo.first;
+	const map<int,string>& naming = graphInfo.second;
+	if (ordering == INPUT_ORDER) {
+		return graphInfo;
+	}
+	vector<Node> order = (ordering == REVERSE_CUTHILL_MCKEE) ?
+			getReverseCuthillMcKeeOrder(g) : getDegeneracyOrder(g);
+	vector<Node> newNumber(g.getNumberOfNodes());
+	for (unsigned int i=0; i<order.size(); i++) {
+		newNumber[order[i]] = i;
+	}
+	Graph reordered(g.getNumberOfNodes());
+	map<int,string> reorderedNaming;
+	for (Node v=0; v<g.getNumberOfNodes(); v++) {
+		for (Node u : g.getNeighbors(v)) {
+			if (v < u) {
+				reordered.addEdge(newNumber[v], newNumber[u]);
+			}
+		}
+		map<int,string>::const_iterator name = naming.find(v);
+		if (name != naming.end()) {
+			reorderedNaming[newNumber[v]] = name->second;
+		}
+	}
+	return make_pair(reordered, reorderedNaming);
+}
+
 } /* namespace tdenum */
 
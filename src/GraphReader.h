@@ -6,6 +6,8 @@
 
 namespace tdenum {
 
+enum NodeOrdering { INPUT_ORDER, REVERSE_CUTHILL_MCKEE, DEGENERACY_ORDER };
+
 class GraphReader {
 public:
 	/**
@@ -26,6 +28,20 @@ public:
 	 * Where all nodes are numbers between 1 and <number-of-nodes>.
 	 */
 	static pair<Graph, map <int,string> > read(const string& fileName);
+	/**
+	 * Reads a graph as above, and renumbers its nodes in the given order to
+	 * improve the locality of the data indexed by nodes.
+	 * The map from the new numbers to the input names is returned, so the
+	 * renumbering does not change the output.
+	 * Reverse Cuthill-McKee numbers the nodes in a reversed BFS order, where
+	 * the nodes of lower degree are visited first. The degeneracy order
+	 * numbers the nodes in the order of repeatedly removing a node of
+	 * minimum degree.
+	 */
+	static pair<Graph, map <int,string> > read(const string& fileName, NodeOrdering ordering);
+	// Renumbers the nodes of the graph in the given order, composing the naming
+	static pair<Graph, map <int,string> > reorder(const pair<Graph, map <int,string> >& graphInfo,
+			NodeOrdering ordering);
 };
 
 } /* namespace tdenum */
@@ -187,7 +187,17 @@ NodeSet IndSetExtBySeparators::mergeComponentAndNeighbors(
 
 }
 
-set<MinimalSeparator> IndSetExtBySeparators::extendToMaxIndependentSet(
+set<SeparatorId> IndSetExtBySeparators::extendToMaxIndependentSet(
+		const set<SeparatorId>& s) {
+
+	return pool.intern(extendSeparators(pool.getSeparators(s)));
+}
+
+IndependentSetExtender<SeparatorId>* IndSetExtBySeparators::clone() const {
+	return new IndSetExtBySeparators(*this);
+}
+
+set<MinimalSeparator> IndSetExtBySeparators::extendSeparators(
 		const set<MinimalSeparator>& minSeps) {
 
 	queue<SubGraph> Q;
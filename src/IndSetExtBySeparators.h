@@ -10,6 +10,7 @@
 
 #include "IndependentSetExtender.h"
 #include "Graph.h"
+#include "SeparatorPool.h"
 #include "SubGraph.h"
 #include <queue>
 #include <algorithm>
@@ -21,8 +22,9 @@ bool sortNodes(int node1, int node2);
 bool isInNodeSet(Node node, const NodeSet& nodes);
 
 
-class IndSetExtBySeparators: public IndependentSetExtender<MinimalSeparator> {
+class IndSetExtBySeparators: public IndependentSetExtender<SeparatorId> {
 	Graph graph;
+	SeparatorPool& pool;
 
 	vector<Node> getUnconnectedNodes(const Graph& graph);
 
@@ -36,22 +38,22 @@ class IndSetExtBySeparators: public IndependentSetExtender<MinimalSeparator> {
 			const NodeSet& compNeighbors);
 	queue<SubGraph> decompose(const SubGraph& mainSubGraph,
 		const set<MinimalSeparator>& s);
+
+	set<MinimalSeparator> extendSeparators(const set<MinimalSeparator>& s);
 	
 
 public:
-	IndSetExtBySeparators(const Graph& graph) :
-			graph(graph) {
-	}
-	;
-
-	IndSetExtBySeparators() {
+	IndSetExtBySeparators(const Graph& graph, SeparatorPool& pool) :
+			graph(graph), pool(pool) {
 	}
 	;
 
 	
 
-	set<MinimalSeparator> extendToMaxIndependentSet(
-			const set<MinimalSeparator>& s) override;
+	set<SeparatorId> extendToMaxIndependentSet(
+			const set<SeparatorId>& s) override;
+
+	IndependentSetExtender<SeparatorId>* clone() const override;
 };
 }
 
@@ -4,18 +4,39 @@
 
 namespace tdenum {
 
-IndSetExtByTriangulation::IndSetExtByTriangulation(const Graph& g, const MinimalTriangulator& t) :
-	graph(g), triangulator(t) {}
+IndSetExtByTriangulation::IndSetExtByTriangulation(const Graph& g, SeparatorPool& pool,
+		const MinimalTriangulator& t) :
+	graph(g), pool(pool), triangulator(t) {
+	if (graph.getNumberOfNodes() <= MAX_NODES_FOR_DENSE_GRAPH) {
+		denseGraph = make_shared<const DenseGraph>(graph);
+	}
+}
 
 
-set<MinimalSeparator> IndSetExtByTriangulation::extendToMaxIndependentSet(
-		const set<MinimalSeparator>& s) {
-	Graph saturatedGraph(graph);
-	saturatedGraph.saturateNodeSets(s);
-	Graph minimalTriangulation = triangulator.triangulate(saturatedGraph);
+set<SeparatorId> IndSetExtByTriangulation::extendToMaxIndependentSet(
+		const set<SeparatorId>& s) {
+	SaturatedGraph saturatedGraph = Converter::minimalSeparatorsToSaturatedGraph(graph, pool, s,
+			denseGraph.get());
+	SaturatedGraph minimalTriangulation = triangulator.triangulate(saturatedGraph);
 	set<MinimalSeparator> minimalSeparators =
 			Converter::triangulationToMinimalSeparators(minimalTriangulation);
-	return minimalSeparators;
+	return pool.intern(minimalSeparators);
+}
+
+/*
+ * The copy has its own triangulator, and shares the pool, which supports
+ * concurrent use.
+ */
+IndependentSetExtender<SeparatorId>* IndSetExtByTriangulation::clone() const {
+	return new IndSetExtByTriangulation(*this);
+}
+
+void IndSetExtByTriangulation::save(CheckpointWriter& output) const {
+	triangulator.save(output);
+}
+
+void IndSetExtByTriangulation::load(CheckpointReader& input) {
+	triangulator.load(input);
 }
 
 } /* namespace tdenum */
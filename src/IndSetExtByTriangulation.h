@@ -3,23 +3,34 @@
 
 #include "IndependentSetExtender.h"
 #include "MinimalTriangulator.h"
+#include "SeparatorPool.h"
 #include "Graph.h"
+#include "DenseGraph.h"
+#include <memory>
 
 namespace tdenum {
 
 /**
  * An implementation of the IndependentSetExtender interface for the case where
- * the nodes are minimal separators.
+ * the nodes are ids of minimal separators in a SeparatorPool.
  * Uses a provided MinimalTriangulator to perform the steps of finding a minimal
  * triangulation.
  */
 class IndSetExtByTriangulation :
-		public IndependentSetExtender<MinimalSeparator>  {
+		public IndependentSetExtender<SeparatorId>  {
 	Graph graph;
+	// A dense copy of graph for the neighbor tests of the triangulations,
+	// shared by the clones, or empty on larger graphs
+	shared_ptr<const DenseGraph> denseGraph;
+	SeparatorPool& pool;
 	MinimalTriangulator triangulator;
 public:
-	IndSetExtByTriangulation(const Graph& g, const MinimalTriangulator& t);
-	virtual set<MinimalSeparator> extendToMaxIndependentSet(const set<MinimalSeparator>& s);
+	IndSetExtByTriangulation(const Graph& g, SeparatorPool& pool, const MinimalTriangulator& t);
+	virtual set<SeparatorId> extendToMaxIndependentSet(const set<SeparatorId>& s);
+	virtual IndependentSetExtender<SeparatorId>* clone() const;
+	// Writes and restores the state of the triangulator
+	void save(CheckpointWriter& output) const;
+	void load(CheckpointReader& input);
 };
 
 } /* namespace tdenum */
@@ -4,32 +4,33 @@
 
 namespace tdenum {
 
-IndSetScorerByTriangulation::IndSetScorerByTriangulation(const Graph& g, TriangulationScoringCriterion c) :
-		graph(g), criterion(c) {}
+IndSetScorerByTriangulation::IndSetScorerByTriangulation(const Graph& g,
+		const SeparatorPool& pool, TriangulationScoringCriterion c) :
+		graph(g), pool(pool), criterion(c) {}
 
 IndSetScorerByTriangulation::~IndSetScorerByTriangulation() {}
 
-int IndSetScorerByTriangulation::scoreIndependentSet(const set<MinimalSeparator>& s) {
+int IndSetScorerByTriangulation::scoreIndependentSet(const set<SeparatorId>& s) {
 	if (criterion == NONE) {
 		return 0;
 	} else if (criterion == WIDTH) {
-		ChordalGraph g = Converter::minimalSeparatorsToTriangulation(graph, s);
-		return g.getTreeWidth();
+		SaturatedGraph g = Converter::minimalSeparatorsToSaturatedGraph(graph, pool, s);
+		return getTreeWidth(g);
 	} else if (criterion == FILL) {
-		ChordalGraph g = Converter::minimalSeparatorsToTriangulation(graph, s);
-		return g.getFillIn(graph);
+		SaturatedGraph g = Converter::minimalSeparatorsToSaturatedGraph(graph, pool, s);
+		return g.getNumberOfFillEdges();
 	} else if (criterion == MAX_SEP_SIZE) {
 		int maxSeparatorSize = 0;
-		for (set<MinimalSeparator>::iterator it = s.begin(); it!=s.end(); ++it) {
-			if (it->size() > (unsigned int)maxSeparatorSize) {
-				maxSeparatorSize = it->size();
+		for (set<SeparatorId>::iterator it = s.begin(); it!=s.end(); ++it) {
+			if (pool.get(*it).size() > maxSeparatorSize) {
+				maxSeparatorSize = pool.get(*it).size();
 			}
 		}
 		return maxSeparatorSize;
 	} else if (criterion == DIFFERENECE) {
 		int score = 0;
-		ChordalGraph g = Converter::minimalSeparatorsToTriangulation(graph, s);
-		vector< set<Node> > fillEdges = g.getFillEdges(graph);
+		SaturatedGraph g = Converter::minimalSeparatorsToSaturatedGraph(graph, pool, s);
+		vector< set<Node> > fillEdges = g.getFillEdges();
 		for (vector< set<Node> >::iterator it=fillEdges.begin(); it!=fillEdges.end(); ++it) {
 			if (seenFillEdges.find(*it) != seenFillEdges.end()) {
 				score++;
@@ -44,12 +45,29 @@ bool IndSetScorerByTriangulation::mayScoreChange() {
 	return (criterion == DIFFERENECE);
 }
 
-void IndSetScorerByTriangulation::independentSetUsed(const set<MinimalSeparator>& s) {
+void IndSetScorerByTriangulation::independentSetUsed(const set<SeparatorId>& s) {
 	if (criterion == DIFFERENECE) {
-		ChordalGraph g = Converter::minimalSeparatorsToTriangulation(graph, s);
-		vector< set<Node> > fillEdges = g.getFillEdges(graph);
+		SaturatedGraph g = Converter::minimalSeparatorsToSaturatedGraph(graph, pool, s);
+		vector< set<Node> > fillEdges = g.getFillEdges();
 		seenFillEdges.insert(fillEdges.begin(), fillEdges.end());
 	}
 }
 
+void IndSetScorerByTriangulation::save(CheckpointWriter& output) const {
+	output.writeNumber(seenFillEdges.size());
+	for (const set<Node>& edge : seenFillEdges) {
+		output.writeSortedNumbers(edge.begin(), edge.end(), edge.size());
+	}
+}
+
+void IndSetScorerByTriangulation::load(CheckpointReader& input) {
+	seenFillEdges.clear();
+	uint64_t size = input.readNumber();
+	for (uint64_t i = 0; i < size && input.isValid(); i++) {
+		set<Node> edge;
+		input.readSortedNumbers<Node>(edge);
+		seenFillEdges.insert(edge);
+	}
+}
+
 } /* namespace tdenum */
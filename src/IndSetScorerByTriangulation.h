@@ -2,7 +2,9 @@
 #define INDSETSCORERBYTRIANGULATION_H_
 
 #include "IndependentSetScorer.h"
+#include "SeparatorPool.h"
 #include "Graph.h"
+#include "Checkpoint.h"
 
 namespace tdenum {
 
@@ -10,21 +12,26 @@ enum TriangulationScoringCriterion { NONE, WIDTH, FILL, MAX_SEP_SIZE, DIFFERENEC
 
 /**
  * An implementation of the IndependentSetScorer interface for the case where
- * the nodes are minimal separators.
+ * the nodes are ids of minimal separators in a SeparatorPool.
  * Uses the conversion to a minimal triangulation to evaluate it.
  * Lower score is better.
  */
 class IndSetScorerByTriangulation :
-		public IndependentSetScorer<MinimalSeparator> {
+		public IndependentSetScorer<SeparatorId> {
 	Graph graph;
+	const SeparatorPool& pool;
 	TriangulationScoringCriterion criterion;
 	set< set<Node> > seenFillEdges;
 public:
-	IndSetScorerByTriangulation(const Graph& g, TriangulationScoringCriterion c);
+	IndSetScorerByTriangulation(const Graph& g, const SeparatorPool& pool,
+			TriangulationScoringCriterion c);
 	virtual ~IndSetScorerByTriangulation();
-	int scoreIndependentSet(const set<MinimalSeparator>& s);
+	int scoreIndependentSet(const set<SeparatorId>& s);
 	bool mayScoreChange();
-	void independentSetUsed(const set<MinimalSeparator>& s);
+	void independentSetUsed(const set<SeparatorId>& s);
+	// Writes and restores the fill edges seen by the difference criterion
+	void save(CheckpointWriter& output) const;
+	void load(CheckpointReader& input);
 };
 
 } /* namespace tdenum */
@@ -2,6 +2,7 @@
 #define INDEPENDENTSETEXTENDER_H_
 
 #include <set>
+#include <cstddef>
 using namespace std;
 
 namespace tdenum {
@@ -24,6 +25,11 @@ public:
 	 * contains it.
 	 */
 	virtual set<T> extendToMaxIndependentSet(const set<T>& s) = 0;
+	/**
+	 * Returns a new copy that can extend sets in another thread, concurrently
+	 * with this one, or NULL if the extender does not support it.
+	 */
+	virtual IndependentSetExtender<T>* clone() const { return NULL; }
 };
 
 } /* namespace tdenum */
@@ -0,0 +1,239 @@
+#ifndef INDEPENDENTSETLOG_H_
+#define INDEPENDENTSETLOG_H_
+
+#include <set>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <stdint.h>
+using namespace std;
+
+namespace tdenum {
+
+/**
+ * A sequence of independent sets kept in an append-only file, for sets that
+ * do not fit in memory. Every set is written as its size followed by the
+ * differences between consecutive nodes, as variable length integers of 7
+ * bits per byte, where the nodes are converted to numbers.
+ *
+ * Only the file offset of every OFFSET_STEP'th set is kept in memory. Reading
+ * the sets in order streams the file, and reading a set at another position
+ * skips at most OFFSET_STEP-1 sets from the nearest kept offset. The last set
+ * read is kept, so reading it again is free. The file is removed when the
+ * log is destroyed.
+ *
+ * A failure to open, write or read the file, such as a full disk, marks the
+ * log as failed, and the sets read afterwards are not valid.
+ */
+template<class T>
+class IndependentSetLog {
+	static const int OFFSET_STEP = 64;
+	static const size_t BUFFER_SIZE = 1 << 16;
+	string fileName;
+	fstream file;
+	// The size of the file, and the bytes appended after it
+	uint64_t fileSize;
+	vector<char> writeBuffer;
+	int numberOfSets;
+	// offsets[i] is the position of set i*OFFSET_STEP
+	vector<uint64_t> offsets;
+	// Bytes read from the file, starting at position readStart
+	vector<char> readBuffer;
+	uint64_t readStart;
+	size_t readIndex;
+	// The position of the next set to read, and the last set read
+	int nextPosition;
+	set<T> lastSet;
+	bool failed;
+
+	void writeNumber(uint64_t number);
+	void flush();
+	// Prepares to read the set at the given position, which is kept in offsets
+	void seek(int position);
+	int readByte();
+	uint64_t readNumber();
+	set<T> readSet();
+
+	IndependentSetLog(const IndependentSetLog&);
+	IndependentSetLog& operator=(const IndependentSetLog&);
+public:
+	// Creates the log in a new file with the given name
+	IndependentSetLog(const string& fileName);
+	~IndependentSetLog();
+	// Adds a set at the end, and returns its position
+	int append(const set<T>& s);
+	// Returns the set at the given position
+	set<T> get(int position);
+	// Returns the number of sets in the log
+	int size() const { return numberOfSets; }
+	// Removes all the sets
+	void clear();
+	// Returns whether the file could be used so far
+	bool isValid() const { return !failed; }
+};
+
+template<class T>
+IndependentSetLog<T>::IndependentSetLog(const string& fileName) : fileName(fileName),
+		fileSize(0), numberOfSets(0), readStart(0), readIndex(0), nextPosition(-1) {
+	file.open(fileName.c_str(), ios::in | ios::out | ios::binary | ios::trunc);
+	failed = !file;
+	writeBuffer.reserve(BUFFER_SIZE);
+}
+
+template<class T>
+IndependentSetLog<T>::~IndependentSetLog() {
+	file.close();
+	remove(fileName.c_str());
+}
+
+template<class T>
+void IndependentSetLog<T>::writeNumber(uint64_t number) {
+	while (number >= 0x80) {
+		writeBuffer.push_back((char)(number | 0x80));
+		number >>= 7;
+	}
+	writeBuffer.push_back((char)number);
+}
+
+template<class T>
+void IndependentSetLog<T>::flush() {
+	if (writeBuffer.empty() || failed) {
+		writeBuffer.clear();
+		return;
+	}
+	file.seekp(fileSize);
+	file.write(writeBuffer.data(), writeBuffer.size());
+	file.flush();
+	if (!file) {
+		failed = true;
+	} else {
+		fileSize += writeBuffer.size();
+	}
+	writeBuffer.clear();
+}
+
+template<class T>
+int IndependentSetLog<T>::append(const set<T>& s) {
+	if (numberOfSets % OFFSET_STEP == 0) {
+		offsets.push_back(fileSize + writeBuffer.size());
+	}
+	writeNumber(s.size());
+	uint64_t previous = 0;
+	for (typename set<T>::const_iterator i = s.begin(); i != s.end(); ++i) {
+		writeNumber((uint64_t)*i - previous);
+		previous = *i;
+	}
+	if (writeBuffer.size() >= BUFFER_SIZE) {
+		flush();
+	}
+	return numberOfSets++;
+}
+
+/*
+ * Keeps the bytes already read if the offset is among them.
+ */
+template<class T>
+void IndependentSetLog<T>::seek(int position) {
+	uint64_t offset = offsets[position / OFFSET_STEP];
+	if (offset >= readStart && offset < readStart + readBuffer.size()) {
+		readIndex = offset - readStart;
+	} else {
+		readStart = offset;
+		readBuffer.clear();
+		readIndex = 0;
+	}
+	nextPosition = position / OFFSET_STEP * OFFSET_STEP;
+}
+
+/*
+ * Reads the next block of the file when the buffer is exhausted. The sets
+ * read are always flushed to the file before, so reading past the end of the
+ * file, or fewer bytes than requested, is a failure.
+ */
+template<class T>
+int IndependentSetLog<T>::readByte() {
+	if (failed) {
+		return 0;
+	}
+	if (readIndex == readBuffer.size()) {
+		readStart += readBuffer.size();
+		size_t size = min((uint64_t)BUFFER_SIZE, fileSize - readStart);
+		readBuffer.resize(size);
+		file.seekg(readStart);
+		file.read(readBuffer.data(), size);
+		readIndex = 0;
+		if (size == 0 || !file || (size_t)file.gcount() != size) {
+			failed = true;
+			readBuffer.clear();
+			return 0;
+		}
+	}
+	return (unsigned char)readBuffer[readIndex++];
+}
+
+template<class T>
+uint64_t IndependentSetLog<T>::readNumber() {
+	uint64_t number = 0;
+	for (int shift = 0; ; shift += 7) {
+		int byte = readByte();
+		number |= (uint64_t)(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0) {
+			return number;
+		}
+	}
+}
+
+template<class T>
+set<T> IndependentSetLog<T>::readSet() {
+	set<T> s;
+	uint64_t size = readNumber();
+	uint64_t previous = 0;
+	for (uint64_t i = 0; i < size && !failed; i++) {
+		previous += readNumber();
+		s.insert(s.end(), (T)previous);
+	}
+	nextPosition++;
+	return s;
+}
+
+/*
+ * Goes to the nearest kept offset unless the set is the next one, or ahead of
+ * it in the same block of sets.
+ */
+template<class T>
+set<T> IndependentSetLog<T>::get(int position) {
+	if (position == nextPosition - 1) {
+		return lastSet;
+	}
+	flush();
+	if (nextPosition < 0 || position < nextPosition || (position != nextPosition &&
+			position / OFFSET_STEP != nextPosition / OFFSET_STEP)) {
+		seek(position);
+	}
+	while (nextPosition < position) {
+		readSet();
+	}
+	lastSet = readSet();
+	return lastSet;
+}
+
+template<class T>
+void IndependentSetLog<T>::clear() {
+	file.close();
+	file.open(fileName.c_str(), ios::in | ios::out | ios::binary | ios::trunc);
+	failed = !file;
+	fileSize = 0;
+	writeBuffer.clear();
+	numberOfSets = 0;
+	offsets.clear();
+	readBuffer.clear();
+	readStart = 0;
+	readIndex = 0;
+	nextPosition = -1;
+	lastSet.clear();
+}
+
+} /* namespace tdenum */
+
+#endif /* INDEPENDENTSETLOG_H_ */
@@ -0,0 +1,233 @@
+#ifndef INDEPENDENTSETSTORE_H_
+#define INDEPENDENTSETSTORE_H_
+
+#include "IndependentSetLog.h"
+#include "DataStructures.h"
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <stdint.h>
+using namespace std;
+
+namespace tdenum {
+
+/**
+ * Returns a 64 bit hash of the set. Different seeds give independent hashes.
+ */
+template<class T>
+uint64_t getIndependentSetHash(const set<T>& s, uint64_t seed) {
+	return hashRange(s.begin(), s.end(), s.size(), seed);
+}
+
+// The seeds of the two hashes of the sets
+const uint64_t FIRST_HASH_SEED = 0x9e3779b97f4a7c15ULL;
+const uint64_t SECOND_HASH_SEED = 0xc2b2ae3d27d4eb4fULL;
+
+/**
+ * Stores every independent set once and identifies it by a dense handle,
+ * assigned in the order the sets are added.
+ * The nodes of all the sets are kept sorted, one set after the other, in a
+ * single array. An open addressing hash table with linear probing over 64 bit
+ * hashes finds the handle of a set, and the nodes are compared only when the
+ * hashes match. Sets are never removed.
+ *
+ * In the external memory mode, the sets are kept in an IndependentSetLog, and
+ * only a second 64 bit hash of every set is kept in memory. Two sets are
+ * taken to be equal when both of their hashes are, so the sets are not read
+ * back to be compared.
+ */
+template<class T>
+class IndependentSetStore {
+	vector<T> nodes;
+	// The set with handle i is nodes[offsets[i]..offsets[i+1])
+	vector<size_t> offsets;
+	vector<uint64_t> hashes;
+	// Every slot holds a handle, or -1 if it is empty
+	vector<int> slots;
+	// The sets in the external memory mode, or NULL
+	IndependentSetLog<T>* log;
+	vector<uint64_t> secondHashes;
+
+	// Returns whether the set with the given handle has exactly the given nodes
+	bool isEqual(int handle, const set<T>& s) const;
+	// Returns the slot holding the handle of the set, or the empty slot where
+	// it would be added
+	size_t findSlot(const set<T>& s, uint64_t hash) const;
+	// Rebuilds the table with the given number of slots, a power of 2
+	void rehash(size_t numberOfSlots);
+
+	IndependentSetStore(const IndependentSetStore&);
+	IndependentSetStore& operator=(const IndependentSetStore&);
+public:
+	// Keeps the sets in a file with the given name in the external memory
+	// mode, and in memory if it is empty
+	IndependentSetStore(const string& logFileName = "") : offsets(1, 0),
+			log(logFileName.empty() ? NULL : new IndependentSetLog<T>(logFileName)) {}
+	~IndependentSetStore() { delete log; }
+	// Returns the handle of the given set, adding it if it is new. Sets
+	// isNew to whether it was added.
+	int insert(const set<T>& s, bool& isNew);
+	// Returns the handle of the given set, or -1 if it is not stored
+	int find(const set<T>& s) const;
+	// Returns the set with the given handle
+	set<T> get(int handle) const;
+	// Returns the number of sets stored
+	int size() const { return hashes.size(); }
+	// Removes all the sets
+	void clear();
+	// Returns whether the file of the sets could be used so far, in the
+	// external memory mode
+	bool isValid() const { return !log || log->isValid(); }
+};
+
+template<class T>
+bool IndependentSetStore<T>::isEqual(int handle, const set<T>& s) const {
+	if (log) {
+		return secondHashes[handle] == getIndependentSetHash(s, SECOND_HASH_SEED);
+	}
+	if (offsets[handle+1] - offsets[handle] != s.size()) {
+		return false;
+	}
+	return equal(s.begin(), s.end(), nodes.begin() + offsets[handle]);
+}
+
+template<class T>
+void IndependentSetStore<T>::rehash(size_t numberOfSlots) {
+	slots.assign(numberOfSlots, -1);
+	size_t mask = numberOfSlots - 1;
+	for (int handle = 0; handle < size(); handle++) {
+		size_t slot = hashes[handle] & mask;
+		while (slots[slot] != -1) {
+			slot = (slot+1) & mask;
+		}
+		slots[slot] = handle;
+	}
+}
+
+template<class T>
+size_t IndependentSetStore<T>::findSlot(const set<T>& s, uint64_t hash) const {
+	size_t mask = slots.size() - 1;
+	size_t slot = hash & mask;
+	while (slots[slot] != -1 && !(hashes[slots[slot]] == hash && isEqual(slots[slot], s))) {
+		slot = (slot+1) & mask;
+	}
+	return slot;
+}
+
+/*
+ * Keeps at most half of the slots used.
+ */
+template<class T>
+int IndependentSetStore<T>::insert(const set<T>& s, bool& isNew) {
+	if (2*(size()+1) > (int)slots.size()) {
+		rehash(slots.empty() ? 64 : 2*slots.size());
+	}
+	uint64_t hash = getIndependentSetHash(s, FIRST_HASH_SEED);
+	size_t slot = findSlot(s, hash);
+	if (slots[slot] != -1) {
+		isNew = false;
+		return slots[slot];
+	}
+	int handle = size();
+	if (log) {
+		log->append(s);
+		secondHashes.push_back(getIndependentSetHash(s, SECOND_HASH_SEED));
+	} else {
+		nodes.insert(nodes.end(), s.begin(), s.end());
+		offsets.push_back(nodes.size());
+	}
+	hashes.push_back(hash);
+	slots[slot] = handle;
+	isNew = true;
+	return handle;
+}
+
+template<class T>
+int IndependentSetStore<T>::find(const set<T>& s) const {
+	if (slots.empty()) {
+		return -1;
+	}
+	return slots[findSlot(s, getIndependentSetHash(s, FIRST_HASH_SEED))];
+}
+
+template<class T>
+set<T> IndependentSetStore<T>::get(int handle) const {
+	if (log) {
+		return log->get(handle);
+	}
+	return set<T>(nodes.begin() + offsets[handle], nodes.begin() + offsets[handle+1]);
+}
+
+template<class T>
+void IndependentSetStore<T>::clear() {
+	nodes.clear();
+	offsets.assign(1, 0);
+	hashes.clear();
+	slots.clear();
+	secondHashes.clear();
+	if (log) {
+		log->clear();
+	}
+}
+
+/**
+ * Stores every independent set once, for several threads at once. The sets
+ * are divided between shards by a hash independent of the one of the slots,
+ * and every shard is an IndependentSetStore in memory with its own lock, so
+ * threads that use different shards do not wait for each other, and threads
+ * that only read a shard share it. The handle of a set is its handle in its
+ * shard times the number of shards, plus its shard.
+ */
+template<class T>
+class ConcurrentIndependentSetStore {
+	struct Shard {
+		// Readers of the shard share it, and adding a set is exclusive
+		mutable shared_mutex lock;
+		IndependentSetStore<T> sets;
+	};
+	vector<Shard> shards;
+
+	ConcurrentIndependentSetStore(const ConcurrentIndependentSetStore&);
+	ConcurrentIndependentSetStore& operator=(const ConcurrentIndependentSetStore&);
+public:
+	ConcurrentIndependentSetStore(int numberOfShards = 64) : shards(numberOfShards) {}
+	// Returns the handle of the given set, adding it if it is new. Sets
+	// isNew to whether it was added.
+	int insert(const set<T>& s, bool& isNew);
+	// Returns the set with the given handle
+	set<T> get(int handle) const;
+};
+
+/*
+ * Most sets inserted were already found, so the shard is first searched
+ * under the shared lock.
+ */
+template<class T>
+int ConcurrentIndependentSetStore<T>::insert(const set<T>& s, bool& isNew) {
+	int shardIndex = getIndependentSetHash(s, SECOND_HASH_SEED) % shards.size();
+	Shard& shard = shards[shardIndex];
+	{
+		shared_lock<shared_mutex> readLock(shard.lock);
+		int handle = shard.sets.find(s);
+		if (handle != -1) {
+			isNew = false;
+			return handle * shards.size() + shardIndex;
+		}
+	}
+	unique_lock<shared_mutex> writeLock(shard.lock);
+	return shard.sets.insert(s, isNew) * shards.size() + shardIndex;
+}
+
+template<class T>
+set<T> ConcurrentIndependentSetStore<T>::get(int handle) const {
+	const Shard& shard = shards[handle % shards.size()];
+	shared_lock<shared_mutex> readLock(shard.lock);
+	return shard.sets.get(handle / shards.size());
+}
+
+} /* namespace tdenum */
+
+#endif /* INDEPENDENTSETSTORE_H_ */
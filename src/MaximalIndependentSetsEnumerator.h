@@ -4,16 +4,51 @@
 #include "SuccinctGraphRepresentation.h"
 #include "IndependentSetExtender.h"
 #include "IndependentSetScorer.h"
+#include "IndependentSetStore.h"
+#include "ExtensionCache.h"
+#include "Checkpoint.h"
+#include "ThreadPool.h"
+#include <string>
+#include <stdint.h>
+#include <unistd.h>
 
 namespace tdenum {
 
 enum AlgorithmStep {BEGINNING, ITERATING_NODES, ITERATING_SETS};
 
+// The number of positions computed ahead for every thread in the parallel mode
+const int EXTENSIONS_AHEAD_PER_THREAD = 32;
+
 /**
  * Enumerates the maximal independent sets of a graph given by a succinct graph
  * representation with an independent set expansion.
  * If the representation and the expansion are polynomial, this algorithm runs
  * in incremental polynomial delay.
+ *
+ * Every set found is stored once, and the state refers to it by its handle.
+ *
+ * With more than one thread, the extensions in the following positions of the
+ * current loop, over the nodes or over the extended sets, are computed ahead
+ * in parallel by copies of the extender, on threads that live as long as the
+ * enumerator. They are then used one by one in the same order as in the
+ * sequential mode, so the results are the same for every number of threads,
+ * as long as the extender gives the same result for the same set. An extender
+ * whose result depends on the sets it extended before, such as the combined
+ * heuristic, may give a different order on every run.
+ *
+ * In the external memory mode, the sets found are kept in a file, and the
+ * sets extended are also written in the order they were extended to another
+ * file, which is read in order by every loop over them. Only the hashes of
+ * the sets and a few offsets into the files are then kept in memory.
+ *
+ * The same base set is often reached from different sets and nodes, so the
+ * extensions of recent base sets are kept in a bounded cache, by the handles
+ * of the sets found, and a repeated base set is not extended again. An
+ * extension is kept when it is stored, whether it is a new set or not.
+ *
+ * Some directions cannot give a new set, and are skipped without extending:
+ * a node of the set itself, whose base set is the set, and a base set that
+ * was already extended in the same loop.
  */
 template<class T>
 class MaximalIndependentSetsEnumerator {
@@ -22,36 +57,100 @@ class MaximalIndependentSetsEnumerator {
 	SuccinctGraphRepresentation<T>& graph;
 	IndependentSetExtender<T>& extender;
 	IndependentSetScorer<T>& scorer;
+	// The extenders used by every thread, where the first is extender and the
+	// others are its copies
+	vector<IndependentSetExtender<T>*> extenders;
+	// The threads that run the extenders, or NULL with a single extender
+	ThreadPool* threads;
 
 	// State
-	set<T> nodesGenerated;
-	set< set<T> > setsExtended;
-	set< set<T> > setsNotExtended;
-	set< pair<int, set<T> > > extendingQueue;
+	vector<T> nodesGenerated;
+	IndependentSetStore<T> setsFound;
+	// The handles of the sets extended, in the order they were extended
+	vector<int> setsExtended;
+	// The sets extended, in the same order, in the external memory mode, or NULL
+	IndependentSetLog<T>* extendedLog;
+	// The scores and handles of the sets that were not extended yet
+	set< pair<int,int> > extendingQueue;
 	bool nextSetReady;
 	set<T> nextIndependentSet;
 	AlgorithmStep step;
 	// State for case ITERATING_NODES
-	typename set<T>::iterator nodesIterator;
+	unsigned int nodesIterator;
 	set<T> currentSet;
 	// State for case ITERATING_SETS
-	typename set< set<T> >::iterator setsIterator;
+	unsigned int setsIterator;
 	T currentNode;
+	// The number of loops started, over the nodes for a new currentSet or over
+	// the sets for a new currentNode
+	int loopNumber;
+	// The extensions computed ahead in the parallel mode, for the positions
+	// starting at extensionsStart of the loop extensionsLoop
+	vector< set<T> > extensionsAhead;
+	int extensionsLoop;
+	unsigned int extensionsStart;
+	ExtensionCache extensionCache;
+	// The two hashes of the base sets extended in the loop baseSetsLoop
+	set< pair<uint64_t,uint64_t> > baseSetsExtended;
+	int baseSetsLoop;
+	long long extensionsSkipped;
+	// For the extensions computed ahead, whether their node is in their set,
+	// and otherwise the hashes of their base sets
+	vector<bool> nodesInSetsAhead;
+	vector< pair<uint64_t,uint64_t> > baseSetsAhead;
 
+	// Returns the name of a new file in the given directory for the sets of
+	// this enumerator of the given kind, or an empty name if it is empty
+	string getLogFileName(const string& directory, const string& kind) const;
+	// Returns the set extended at the given position
+	set<T> getExtendedSet(unsigned int position);
 	void getNextSetToExtend();
-	set<T> extendSetInDirectionOfNode(const set<T>& set, const T& node);
-	bool newSetFound(const set<T>& set);
+	// Returns the two hashes of the base set
+	pair<uint64_t,uint64_t> getBaseSetHashes(const set<T>& baseNodes) const;
+	// Returns whether the base set with the given hashes was extended in the
+	// current loop
+	bool isBaseSetExtended(const pair<uint64_t,uint64_t>& hashes) const;
+	void markBaseSetExtended(const pair<uint64_t,uint64_t>& hashes);
+	// Returns whether the extension of the base set with the given hashes is
+	// in the cache, and if so saves it to extension
+	bool findCachedExtension(const pair<uint64_t,uint64_t>& hashes, set<T>& extension);
+	// Saves the extension of the set in the direction of the node to
+	// extension, and the hashes of its base set to hashes. Returns false if
+	// the direction is skipped.
+	bool extendSetInDirectionOfNode(const set<T>& s, const T& node, set<T>& extension,
+			pair<uint64_t,uint64_t>& hashes);
+	// Saves the extension at the given position of the current loop, over the
+	// nodes or over the extended sets, to extension, and the hashes of its
+	// base set to hashes. Returns false if the direction is skipped.
+	bool extendAt(bool isIteratingNodes, unsigned int position, set<T>& extension,
+			pair<uint64_t,uint64_t>& hashes);
+	// Computes the extensions from the given position of the current loop in parallel
+	void extendAhead(bool isIteratingNodes, unsigned int position);
+	// Stores the set, and returns its handle. Sets isNew to whether it was new.
+	int newSetFound(const set<T>& set, bool& isNew);
+	// Stores the extension of the base set with the given hashes, keeps it in
+	// the cache, and returns whether it was new
+	bool newExtensionFound(const set<T>& extension, const pair<uint64_t,uint64_t>& hashes);
 	bool runFullEnumeration();
+	// Finds the next set, without checking the files of the sets
+	bool findNextSet();
 public:
 	MaximalIndependentSetsEnumerator(const MaximalIndependentSetsEnumerator& m) :
-		graph(m.graph), extender(m.extender), scorer(m.scorer){}
+		graph(m.graph), extender(m.extender), scorer(m.scorer), extenders(1, &m.extender),
+		threads(NULL), extendedLog(NULL){}
 	MaximalIndependentSetsEnumerator& operator=(const MaximalIndependentSetsEnumerator& a){return *this;}
 	/**
 	 * Initialization. Receives a succinct graph representation with an
-	 * independent set expansion.
+	 * independent set expansion. The extensions are computed by the given
+	 * number of threads if the extender can be copied, and sequentially otherwise.
+	 * If a directory is given, the sets are kept in files in it. The
+	 * extensions of at most the given number of base sets are cached.
 	 */
 	MaximalIndependentSetsEnumerator(SuccinctGraphRepresentation<T>& graph,
-			IndependentSetExtender<T>& extender, IndependentSetScorer<T>& scorer);
+			IndependentSetExtender<T>& extender, IndependentSetScorer<T>& scorer,
+			int numberOfThreads = 1, const string& externalDirectory = "",
+			int extensionCacheSize = DEFAULT_EXTENSION_CACHE_ENTRIES);
+	~MaximalIndependentSetsEnumerator();
 	/**
 	 * Checks whether there is another maximal independent set.
 	 */
@@ -60,6 +159,31 @@ public:
 	 * Returns another maximal independent set.
 	 */
 	set<T> next();
+	/**
+	 * Returns whether the files of the sets could be used so far, in the
+	 * external memory mode. Once they fail, no more sets are returned.
+	 */
+	bool isValid() const;
+	/**
+	 * Returns the number of extensions found in the cache, and the number of
+	 * extensions computed while the cache was used.
+	 */
+	long long getExtensionCacheHits() const;
+	long long getExtensionCacheMisses() const;
+	/**
+	 * Returns the number of directions skipped without extending.
+	 */
+	long long getExtensionsSkipped() const;
+	/**
+	 * Writes the state of the enumeration. The nodes are written as numbers.
+	 */
+	void save(CheckpointWriter& output) const;
+	/**
+	 * Continues the enumeration from a saved state, of an enumerator of the
+	 * same graph with the same extender and scorer, which are restored
+	 * separately.
+	 */
+	void load(CheckpointReader& input);
 };
 
 
@@ -69,66 +193,236 @@ public:
  */
 template<class T>
 void MaximalIndependentSetsEnumerator<T>::getNextSetToExtend() {
-	pair<int, set<T> > currentScoredSet = *extendingQueue.begin();
+	pair<int,int> currentScoredSet = *extendingQueue.begin();
+	currentSet = setsFound.get(currentScoredSet.second);
+	loopNumber++;
 	if (scorer.mayScoreChange()) {
 		// Support for changing scores: Maybe choose a different set if the score has changed
-		int currentScore = scorer.scoreIndependentSet(currentScoredSet.second);
+		int currentScore = scorer.scoreIndependentSet(currentSet);
 		while (currentScore > currentScoredSet.first) {
 			// Update weight
-			pair<int, set<T> > rescoredSet = make_pair(currentScore, currentScoredSet.second);
+			pair<int,int> rescoredSet = make_pair(currentScore, currentScoredSet.second);
 			extendingQueue.erase(currentScoredSet);
 			extendingQueue.insert(rescoredSet);
 			// Choose new set
 			currentScoredSet = *extendingQueue.begin();
-			currentScore = scorer.scoreIndependentSet(currentScoredSet.second);
+			currentSet = setsFound.get(currentScoredSet.second);
+			currentScore = scorer.scoreIndependentSet(currentSet);
 		}
 	}
-	currentSet = currentScoredSet.second;
 	// Update that this set is being extended
 	scorer.independentSetUsed(currentSet);
-	setsExtended.insert(currentSet);
-	setsNotExtended.erase(currentSet);
+	setsExtended.push_back(currentScoredSet.second);
+	if (extendedLog) {
+		extendedLog->append(currentSet);
+	}
 	extendingQueue.erase(currentScoredSet);
 }
 
 
+/*
+ * The process id and the address of the enumerator tell apart the files of
+ * different enumerators.
+ */
+template<class T>
+string MaximalIndependentSetsEnumerator<T>::getLogFileName(const string& directory,
+		const string& kind) const {
+	if (directory.empty()) {
+		return "";
+	}
+	return directory + "/sets_" + to_string(getpid()) + "_" +
+			to_string((uintptr_t)this) + "_" + kind + ".log";
+}
+
+
+template<class T>
+set<T> MaximalIndependentSetsEnumerator<T>::getExtendedSet(unsigned int position) {
+	if (extendedLog) {
+		return extendedLog->get(position);
+	}
+	return setsFound.get(setsExtended[position]);
+}
+
+
 /*
  * Input: maximal independent set and node.
  * Creates a maximal independent set containing the given node and the nodes
- * from the given set that do not share an edge with the given node.
+ * from the given set that do not share an edge with the given node. A node of
+ * the set gives the set itself, and a base set extended before in this loop
+ * gives a set that was already found, so both are skipped.
  */
 template<class T>
-set<T> MaximalIndependentSetsEnumerator<T>::extendSetInDirectionOfNode(
-		const set<T>& s, const T& node) {
-	set<T> baseNodes;
+bool MaximalIndependentSetsEnumerator<T>::extendSetInDirectionOfNode(
+		const set<T>& s, const T& node, set<T>& extension, pair<uint64_t,uint64_t>& hashes) {
+	if (s.find(node) != s.end()) {
+		extensionsSkipped++;
+		return false;
+	}
+	set<T> baseNodes = graph.getNonNeighbors(node, s);
 	baseNodes.insert(node);
-	for (typename set<T>::iterator i=s.begin(); i!=s.end(); ++i) {
-		if (!graph.hasEdge(node, *i)) {
-			baseNodes.insert(*i);
+	hashes = getBaseSetHashes(baseNodes);
+	if (isBaseSetExtended(hashes)) {
+		extensionsSkipped++;
+		return false;
+	}
+	markBaseSetExtended(hashes);
+	if (findCachedExtension(hashes, extension)) {
+		return true;
+	}
+	extension = extender.extendToMaxIndependentSet(baseNodes);
+	return true;
+}
+
+
+template<class T>
+pair<uint64_t,uint64_t> MaximalIndependentSetsEnumerator<T>::getBaseSetHashes(
+		const set<T>& baseNodes) const {
+	return make_pair(getIndependentSetHash(baseNodes, FIRST_HASH_SEED),
+			getIndependentSetHash(baseNodes, SECOND_HASH_SEED));
+}
+
+
+template<class T>
+bool MaximalIndependentSetsEnumerator<T>::isBaseSetExtended(
+		const pair<uint64_t,uint64_t>& hashes) const {
+	return baseSetsLoop == loopNumber && baseSetsExtended.find(hashes) != baseSetsExtended.end();
+}
+
+
+/*
+ * The base sets of the previous loop are dropped when a new loop starts.
+ */
+template<class T>
+void MaximalIndependentSetsEnumerator<T>::markBaseSetExtended(
+		const pair<uint64_t,uint64_t>& hashes) {
+	if (baseSetsLoop != loopNumber) {
+		baseSetsExtended.clear();
+		baseSetsLoop = loopNumber;
+	}
+	baseSetsExtended.insert(hashes);
+}
+
+
+template<class T>
+bool MaximalIndependentSetsEnumerator<T>::findCachedExtension(
+		const pair<uint64_t,uint64_t>& hashes, set<T>& extension) {
+	if (!extensionCache.isEnabled()) {
+		return false;
+	}
+	int handle = extensionCache.find(hashes.first, hashes.second);
+	if (handle == -1) {
+		return false;
+	}
+	extension = setsFound.get(handle);
+	return true;
+}
+
+
+/*
+ * The directions computed ahead are skipped here, in the order of the
+ * positions, so the same directions are skipped as in the sequential mode.
+ */
+template<class T>
+bool MaximalIndependentSetsEnumerator<T>::extendAt(bool isIteratingNodes,
+		unsigned int position, set<T>& extension, pair<uint64_t,uint64_t>& hashes) {
+	if (extenders.size() == 1) {
+		return isIteratingNodes ?
+				extendSetInDirectionOfNode(currentSet, nodesGenerated[position], extension, hashes) :
+				extendSetInDirectionOfNode(getExtendedSet(position), currentNode, extension, hashes);
+	}
+	if (extensionsLoop != loopNumber || position < extensionsStart ||
+			position >= extensionsStart + extensionsAhead.size()) {
+		extendAhead(isIteratingNodes, position);
+	}
+	unsigned int index = position - extensionsStart;
+	if (nodesInSetsAhead[index] || isBaseSetExtended(baseSetsAhead[index])) {
+		extensionsSkipped++;
+		return false;
+	}
+	markBaseSetExtended(baseSetsAhead[index]);
+	extension = extensionsAhead[index];
+	hashes = baseSetsAhead[index];
+	return true;
+}
+
+
+/*
+ * The base sets are found by the calling thread, since the graph is not
+ * shared, and so are the extensions in the cache and the directions that will
+ * be skipped. Every thread then takes the next of the other sets until none
+ * are left.
+ */
+template<class T>
+void MaximalIndependentSetsEnumerator<T>::extendAhead(bool isIteratingNodes,
+		unsigned int position) {
+	unsigned int loopSize = isIteratingNodes ? nodesGenerated.size() : setsExtended.size();
+	unsigned int numberOfThreads = extenders.size();
+	unsigned int end = min(loopSize, position + EXTENSIONS_AHEAD_PER_THREAD*numberOfThreads);
+	vector< set<T> > baseSets(end - position);
+	extensionsAhead.assign(end - position, set<T>());
+	nodesInSetsAhead.assign(end - position, false);
+	baseSetsAhead.assign(end - position, make_pair(0, 0));
+	set< pair<uint64_t,uint64_t> > baseSetsBefore;
+	vector<unsigned int> positionsToExtend;
+	for (unsigned int i = position; i < end; i++) {
+		const T& node = isIteratingNodes ? nodesGenerated[i] : currentNode;
+		set<T> s = isIteratingNodes ? currentSet : getExtendedSet(i);
+		unsigned int index = i - position;
+		if (s.find(node) != s.end()) {
+			nodesInSetsAhead[index] = true;
+			continue;
+		}
+		baseSets[index] = graph.getNonNeighbors(node, s);
+		baseSets[index].insert(node);
+		baseSetsAhead[index] = getBaseSetHashes(baseSets[index]);
+		if (isBaseSetExtended(baseSetsAhead[index]) ||
+				!baseSetsBefore.insert(baseSetsAhead[index]).second) {
+			continue;
 		}
+		if (!findCachedExtension(baseSetsAhead[index], extensionsAhead[index])) {
+			positionsToExtend.push_back(index);
+		}
+	}
+	if (!positionsToExtend.empty()) {
+		threads->run(positionsToExtend.size(), [&](int thread, int j) {
+			unsigned int i = positionsToExtend[j];
+			extensionsAhead[i] = extenders[thread]->extendToMaxIndependentSet(baseSets[i]);
+		});
 	}
-	return extender.extendToMaxIndependentSet(baseNodes);
+	extensionsLoop = loopNumber;
+	extensionsStart = position;
 }
 
 
 /*
  * Input: maximal independent set.
- * If this set is new, it is inserted to setsNotExtended and extendingQueue,
- * and saved to nextIndependentSet.
- * Returns whether this set was new.
+ * If this set is new, it is stored, inserted to extendingQueue, and saved to
+ * nextIndependentSet.
  */
 template<class T>
-bool MaximalIndependentSetsEnumerator<T>::newSetFound(const set<T>& generatedSet) {
-	if (setsExtended.find(generatedSet) == setsExtended.end()) {
-		pair<typename set< set<T> >::iterator, bool> insertionReturnValue = setsNotExtended.insert(generatedSet);
-		if (insertionReturnValue.second) {
-			extendingQueue.insert(make_pair(scorer.scoreIndependentSet(generatedSet), generatedSet));
-			nextIndependentSet = generatedSet;
-			nextSetReady = true;
-			return true;
-		}
+int MaximalIndependentSetsEnumerator<T>::newSetFound(const set<T>& generatedSet,
+		bool& isNew) {
+	int handle = setsFound.insert(generatedSet, isNew);
+	if (isNew) {
+		extendingQueue.insert(make_pair(scorer.scoreIndependentSet(generatedSet), handle));
+		nextIndependentSet = generatedSet;
+		nextSetReady = true;
 	}
-	return false;
+	return handle;
+}
+
+
+/*
+ * The extension is kept by its handle once it is stored, so a base set
+ * extended to a new set is not extended again either.
+ */
+template<class T>
+bool MaximalIndependentSetsEnumerator<T>::newExtensionFound(const set<T>& extension,
+		const pair<uint64_t,uint64_t>& hashes) {
+	bool isNew;
+	int handle = newSetFound(extension, isNew);
+	extensionCache.insert(hashes.first, hashes.second, handle);
+	return isNew;
 }
 
 
@@ -136,22 +430,25 @@ template<class T>
 bool MaximalIndependentSetsEnumerator<T>::runFullEnumeration() {
 	while (!extendingQueue.empty()) {
 		getNextSetToExtend();
-		for (nodesIterator = nodesGenerated.begin();
-				nodesIterator != nodesGenerated.end(); ++nodesIterator) {
-			set<T> generatedSet = extendSetInDirectionOfNode(currentSet, *nodesIterator);
-			if (newSetFound(generatedSet)) {
+		for (nodesIterator = 0; nodesIterator < nodesGenerated.size(); ++nodesIterator) {
+			set<T> generatedSet;
+			pair<uint64_t,uint64_t> hashes;
+			if (extendAt(true, nodesIterator, generatedSet, hashes) &&
+					newExtensionFound(generatedSet, hashes)) {
 				step = ITERATING_NODES;
 				return true;
 			}
 		}
-		while(setsNotExtended.empty() && graph.hasNextNode()) {
+		while(extendingQueue.empty() && graph.hasNextNode()) {
 			// generate a new node and extend returned sets in this direction
 			currentNode = graph.nextNode();
-			nodesGenerated.insert(currentNode);
-			for (setsIterator = setsExtended.begin();
-					setsIterator != setsExtended.end(); ++setsIterator) {
-				set<T> generatedSet = extendSetInDirectionOfNode(*setsIterator, currentNode);
-				if (newSetFound(generatedSet)) {
+			nodesGenerated.push_back(currentNode);
+			loopNumber++;
+			for (setsIterator = 0; setsIterator < setsExtended.size(); ++setsIterator) {
+				set<T> generatedSet;
+				pair<uint64_t,uint64_t> hashes;
+				if (extendAt(false, setsIterator, generatedSet, hashes) &&
+						newExtensionFound(generatedSet, hashes)) {
 					step = ITERATING_SETS;
 					return true;
 				}
@@ -168,37 +465,93 @@ bool MaximalIndependentSetsEnumerator<T>::runFullEnumeration() {
 template<class T>
 MaximalIndependentSetsEnumerator<T>::MaximalIndependentSetsEnumerator(
 		SuccinctGraphRepresentation<T>& g, IndependentSetExtender<T>& e,
-		IndependentSetScorer<T>& s) : graph(g), extender(e), scorer (s) {
-	newSetFound(extender.extendToMaxIndependentSet(set<T>()));
+		IndependentSetScorer<T>& s, int numberOfThreads, const string& externalDirectory,
+		int extensionCacheSize) :
+		graph(g), extender(e), scorer (s), extenders(1, &e), threads(NULL),
+		setsFound(getLogFileName(externalDirectory, "found")), extendedLog(NULL),
+		loopNumber(0), extensionsLoop(-1), extensionsStart(0),
+		extensionCache(extensionCacheSize), baseSetsLoop(-1), extensionsSkipped(0) {
+	if (!externalDirectory.empty()) {
+		extendedLog = new IndependentSetLog<T>(getLogFileName(externalDirectory, "extended"));
+	}
+	for (int t = 1; t < numberOfThreads; t++) {
+		IndependentSetExtender<T>* copy = extender.clone();
+		if (copy == NULL) {
+			break;
+		}
+		extenders.push_back(copy);
+	}
+	if (extenders.size() > 1) {
+		threads = new ThreadPool(extenders.size());
+	}
+	bool isNew;
+	newSetFound(extender.extendToMaxIndependentSet(set<T>()), isNew);
 	step = BEGINNING;
 }
 
 
+template<class T>
+MaximalIndependentSetsEnumerator<T>::~MaximalIndependentSetsEnumerator() {
+	delete extendedLog;
+	delete threads;
+	for (unsigned int t = 1; t < extenders.size(); t++) {
+		delete extenders[t];
+	}
+}
+
+
 /*
- * Outputs whether there is a maximal independent set not yet returned.
+ * Outputs whether there is a maximal independent set not yet returned. A set
+ * found while the files failed may have been extended from wrong sets, so it
+ * is not returned.
  */
 template<class T>
 bool MaximalIndependentSetsEnumerator<T>::hasNext() {
+	if (!isValid()) {
+		return false;
+	}
+	bool isFound = findNextSet();
+	if (!isValid()) {
+		nextSetReady = false;
+		return false;
+	}
+	return isFound;
+}
+
+
+template<class T>
+bool MaximalIndependentSetsEnumerator<T>::isValid() const {
+	return setsFound.isValid() && (!extendedLog || extendedLog->isValid());
+}
+
+
+template<class T>
+bool MaximalIndependentSetsEnumerator<T>::findNextSet() {
 	if (nextSetReady) {
 		return true;
 	} else {
 		if (step == BEGINNING) {
 			return runFullEnumeration();
 		} else if (step == ITERATING_NODES) {
-			for (; nodesIterator != nodesGenerated.end(); ++nodesIterator) {
-				set<T> generatedSet = extendSetInDirectionOfNode(currentSet, *nodesIterator);
-				if (newSetFound(generatedSet)) {
+			for (; nodesIterator < nodesGenerated.size(); ++nodesIterator) {
+				set<T> generatedSet;
+				pair<uint64_t,uint64_t> hashes;
+				if (extendAt(true, nodesIterator, generatedSet, hashes) &&
+						newExtensionFound(generatedSet, hashes)) {
 					step = ITERATING_NODES;
 					return true;
 				}
 			}
-			while(setsNotExtended.empty() && graph.hasNextNode()) {
+			while(extendingQueue.empty() && graph.hasNextNode()) {
 				// generate a new node and extend returned sets in this direction
 				currentNode = graph.nextNode();
-				nodesGenerated.insert(currentNode);
-				for (setsIterator = setsExtended.begin(); setsIterator != setsExtended.end(); ++setsIterator) {
-					set<T> generatedSet = extendSetInDirectionOfNode(*setsIterator, currentNode);
-					if (newSetFound(generatedSet)) {
+				nodesGenerated.push_back(currentNode);
+				loopNumber++;
+				for (setsIterator = 0; setsIterator < setsExtended.size(); ++setsIterator) {
+					set<T> generatedSet;
+					pair<uint64_t,uint64_t> hashes;
+					if (extendAt(false, setsIterator, generatedSet, hashes) &&
+							newExtensionFound(generatedSet, hashes)) {
 						step = ITERATING_SETS;
 						return true;
 					}
@@ -206,20 +559,25 @@ bool MaximalIndependentSetsEnumerator<T>::hasNext() {
 			}
 			return runFullEnumeration();
 		} else if (step == ITERATING_SETS) {
-			for (; setsIterator != setsExtended.end(); ++setsIterator) {
-				set<T> generatedSet = extendSetInDirectionOfNode(*setsIterator, currentNode);
-				if (newSetFound(generatedSet)) {
+			for (; setsIterator < setsExtended.size(); ++setsIterator) {
+				set<T> generatedSet;
+				pair<uint64_t,uint64_t> hashes;
+				if (extendAt(false, setsIterator, generatedSet, hashes) &&
+						newExtensionFound(generatedSet, hashes)) {
 					step = ITERATING_SETS;
 					return true;
 				}
 			}
-			while(setsNotExtended.empty() && graph.hasNextNode()) {
+			while(extendingQueue.empty() && graph.hasNextNode()) {
 				// generate a new node and extend returned sets in this direction
 				currentNode = graph.nextNode();
-				nodesGenerated.insert(currentNode);
-				for (setsIterator = setsExtended.begin(); setsIterator != setsExtended.end(); ++setsIterator) {
-					set<T> generatedSet = extendSetInDirectionOfNode(*setsIterator, currentNode);
-					if (newSetFound(generatedSet)) {
+				nodesGenerated.push_back(currentNode);
+				loopNumber++;
+				for (setsIterator = 0; setsIterator < setsExtended.size(); ++setsIterator) {
+					set<T> generatedSet;
+					pair<uint64_t,uint64_t> hashes;
+					if (extendAt(false, setsIterator, generatedSet, hashes) &&
+							newExtensionFound(generatedSet, hashes)) {
 						step = ITERATING_SETS;
 						return true;
 					}
@@ -246,6 +604,127 @@ set<T> MaximalIndependentSetsEnumerator<T>::next() {
 	return set<T>();
 }
 
+
+template<class T>
+long long MaximalIndependentSetsEnumerator<T>::getExtensionCacheHits() const {
+	return extensionCache.getNumberOfHits();
+}
+
+
+template<class T>
+long long MaximalIndependentSetsEnumerator<T>::getExtensionCacheMisses() const {
+	return extensionCache.getNumberOfMisses();
+}
+
+
+template<class T>
+long long MaximalIndependentSetsEnumerator<T>::getExtensionsSkipped() const {
+	return extensionsSkipped;
+}
+
+
+/*
+ * The sets found are written in the order of their handles, so they get the
+ * same handles when they are loaded.
+ */
+template<class T>
+void MaximalIndependentSetsEnumerator<T>::save(CheckpointWriter& output) const {
+	output.writeNumber(nodesGenerated.size());
+	for (unsigned int i = 0; i < nodesGenerated.size(); i++) {
+		output.writeNumber(nodesGenerated[i]);
+	}
+	output.writeNumber(setsFound.size());
+	for (int handle = 0; handle < setsFound.size(); handle++) {
+		set<T> s = setsFound.get(handle);
+		output.writeSortedNumbers(s.begin(), s.end(), s.size());
+	}
+	output.writeNumber(setsExtended.size());
+	for (unsigned int i = 0; i < setsExtended.size(); i++) {
+		output.writeNumber(setsExtended[i]);
+	}
+	output.writeNumber(extendingQueue.size());
+	for (typename set< pair<int,int> >::const_iterator i = extendingQueue.begin();
+			i != extendingQueue.end(); ++i) {
+		output.writeSignedNumber(i->first);
+		output.writeNumber(i->second);
+	}
+	output.writeNumber(nextSetReady);
+	output.writeSortedNumbers(nextIndependentSet.begin(), nextIndependentSet.end(),
+			nextIndependentSet.size());
+	output.writeNumber(step);
+	output.writeNumber(nodesIterator);
+	output.writeSortedNumbers(currentSet.begin(), currentSet.end(), currentSet.size());
+	output.writeNumber(setsIterator);
+	output.writeNumber(currentNode);
+	extensionCache.save(output);
+	// Only the base sets of the current loop are used
+	bool isLoopStarted = baseSetsLoop == loopNumber;
+	output.writeNumber(isLoopStarted ? baseSetsExtended.size() : 0);
+	if (isLoopStarted) {
+		for (typename set< pair<uint64_t,uint64_t> >::const_iterator i =
+				baseSetsExtended.begin(); i != baseSetsExtended.end(); ++i) {
+			output.writeNumber(i->first);
+			output.writeNumber(i->second);
+		}
+	}
+	output.writeNumber(extensionsSkipped);
+}
+
+
+template<class T>
+void MaximalIndependentSetsEnumerator<T>::load(CheckpointReader& input) {
+	nodesGenerated.clear();
+	uint64_t numberOfNodes = input.readNumber();
+	for (uint64_t i = 0; i < numberOfNodes && input.isValid(); i++) {
+		nodesGenerated.push_back((T)input.readNumber());
+	}
+	setsFound.clear();
+	uint64_t numberOfSets = input.readNumber();
+	for (uint64_t i = 0; i < numberOfSets && input.isValid(); i++) {
+		set<T> s;
+		input.readSortedNumbers<T>(s);
+		bool isNew;
+		setsFound.insert(s, isNew);
+	}
+	setsExtended.clear();
+	uint64_t numberOfExtended = input.readNumber();
+	for (uint64_t i = 0; i < numberOfExtended && input.isValid(); i++) {
+		setsExtended.push_back(input.readNumber());
+	}
+	if (extendedLog) {
+		extendedLog->clear();
+		for (unsigned int i = 0; i < setsExtended.size(); i++) {
+			extendedLog->append(setsFound.get(setsExtended[i]));
+		}
+	}
+	extendingQueue.clear();
+	uint64_t queueSize = input.readNumber();
+	for (uint64_t i = 0; i < queueSize && input.isValid(); i++) {
+		int score = input.readSignedNumber();
+		extendingQueue.insert(make_pair(score, (int)input.readNumber()));
+	}
+	nextSetReady = input.readNumber();
+	nextIndependentSet.clear();
+	input.readSortedNumbers<T>(nextIndependentSet);
+	step = (AlgorithmStep)input.readNumber();
+	nodesIterator = input.readNumber();
+	currentSet.clear();
+	input.readSortedNumbers<T>(currentSet);
+	setsIterator = input.readNumber();
+	currentNode = (T)input.readNumber();
+	extensionCache.load(input);
+	baseSetsExtended.clear();
+	uint64_t numberOfBaseSets = input.readNumber();
+	for (uint64_t i = 0; i < numberOfBaseSets && input.isValid(); i++) {
+		uint64_t firstHash = input.readNumber();
+		baseSetsExtended.insert(make_pair(firstHash, input.readNumber()));
+	}
+	baseSetsLoop = loopNumber;
+	extensionsSkipped = input.readNumber();
+	// The extensions computed ahead are not saved
+	extensionsLoop = -1;
+}
+
 } /* namespace tdenum */
 
 #endif /* MAXIMALINDEPENDENTSETSENUMERATOR_H_ */
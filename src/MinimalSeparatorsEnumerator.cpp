@@ -1,15 +1,37 @@
 #include "MinimalSeparatorsEnumerator.h"
+#include <algorithm>
 
 namespace tdenum {
 
+// The number of separators processed together in the parallel mode. It does
+// not depend on the number of threads, so the order of the results does not either.
+static const int SEPARATORS_PER_BATCH = 64;
+
 /*
  * Initialization
  */
-MinimalSeparatorsEnumerator::MinimalSeparatorsEnumerator(const Graph& g, SeparatorsScoringCriterion c) :
-	graph(g), scorer(g,c) {
+MinimalSeparatorsEnumerator::MinimalSeparatorsEnumerator(const Graph& g,
+		SeparatorsScoringCriterion c, int numberOfThreads, int maxSize) :
+	graph(g), scorer(g,c), numberOfThreads(numberOfThreads), maxSize(maxSize),
+	threads(numberOfThreads > 1 ? numberOfThreads : 1) {
+	if (numberOfThreads > 1) {
+		threadBuffers.resize(numberOfThreads);
+		for (ThreadBuffers& buffers : threadBuffers) {
+			buffers.removedNodes.resize(g.getNumberOfNodes());
+		}
+		// The initialization phase is the processing of the empty set with every node
+		vector<MinimalSeparator> bases(1);
+		vector< pair<int,Node> > pairs;
+		for (Node v = 0; v < g.getNumberOfNodes(); v++) {
+			pairs.push_back(make_pair(0, v));
+		}
+		processInParallel(bases, pairs);
+		return;
+	}
 	// Initialize separatorsNotReturned according to the initialization phase
 	for (Node v = 0; v < g.getNumberOfNodes(); v++) {
-		set<Node> vAndNeighbors = graph.getNeighbors(v);
+		NodeBitset vAndNeighbors(g.getNumberOfNodes());
+		vAndNeighbors.insertAll(graph.getNeighbors(v));
 		vAndNeighbors.insert(v);
 		vector<NodeSet> components = graph.getComponents(vAndNeighbors);
 		for (vector<NodeSet>::iterator it=components.begin(); it!=components.end(); ++it) {
@@ -26,7 +48,10 @@ MinimalSeparatorsEnumerator::MinimalSeparatorsEnumerator(const Graph& g, Separat
  * Outputs whether there is a separator not yet returned.
  */
 bool MinimalSeparatorsEnumerator::hasNext() {
-	return !separatorsToExtend.isEmpty();
+	while (separatorsProcessed.empty() && !separatorsToExtend.isEmpty()) {
+		processNext();
+	}
+	return !separatorsProcessed.empty();
 }
 
 /*
@@ -41,29 +66,125 @@ void MinimalSeparatorsEnumerator::minimalSeparatorFound(const MinimalSeparator&
 	}
 }
 
+/*
+ * Every thread takes the next unprocessed pair until none are left, and
+ * collects the separators that were not queued or processed before, with the
+ * pair and the position they were found in. Nothing is written to the queue
+ * or to the processed separators while the threads run, so they are read
+ * without locks. The calling thread, which also takes pairs, then queues the
+ * new ones in the order of the pairs, so the order does not depend on which
+ * thread found a separator first.
+ */
+void MinimalSeparatorsEnumerator::processInParallel(
+		const vector<MinimalSeparator>& bases, const vector< pair<int,Node> >& pairs) {
+	threads.run(pairs.size(), [&](int thread, int i) {
+		ThreadBuffers& buffers = threadBuffers[thread];
+		buffers.removedNodes.clear();
+		buffers.removedNodes.insertAll(bases[pairs[i].first]);
+		Node x = pairs[i].second;
+		buffers.removedNodes.insertAll(graph.getNeighbors(x));
+		buffers.removedNodes.insert(x);
+		graph.getComponents(buffers.removedNodes, buffers.components);
+		for (unsigned int j = 0; j < buffers.components.size(); j++) {
+			NodeSet& componentNeighbors = buffers.componentNeighbors;
+			graph.getNeighbors(buffers.components[j], componentNeighbors);
+			if (!componentNeighbors.empty() && !separatorsExtended.isMember(componentNeighbors)
+					&& !separatorsToExtend.contains(componentNeighbors)) {
+				buffers.newSeparators.push_back(make_pair(make_pair((size_t)i, j), componentNeighbors));
+			}
+		}
+	});
+	vector< pair< pair<size_t,int>, MinimalSeparator > > allNewSeparators;
+	for (ThreadBuffers& buffers : threadBuffers) {
+		allNewSeparators.insert(allNewSeparators.end(), buffers.newSeparators.begin(), buffers.newSeparators.end());
+		buffers.newSeparators.clear();
+	}
+	sort(allNewSeparators.begin(), allNewSeparators.end());
+	for (const pair< pair<size_t,int>, MinimalSeparator >& found : allNewSeparators) {
+		// Pairs of the same batch may find the same separator
+		if (!separatorsToExtend.contains(found.second)) {
+			minimalSeparatorFound(found.second);
+		}
+	}
+}
+
 /*
  * Processes a separator that was not yet processed, transfers it to the list of
- * returned separators, and returns it.
+ * returned separators, and keeps it to be returned if it is not too large.
  */
-MinimalSeparator MinimalSeparatorsEnumerator::next() {
-	// Verify that there is another separator
-	if (!hasNext()) {
-		return MinimalSeparator();
+void MinimalSeparatorsEnumerator::processNext() {
+	if (numberOfThreads > 1) {
+		// Process the next batch of separators together
+		vector<MinimalSeparator> batch;
+		vector< pair<int,Node> > pairs;
+		while (batch.size() < SEPARATORS_PER_BATCH && !separatorsToExtend.isEmpty()) {
+			MinimalSeparator s = separatorsToExtend.pop();
+			separatorsExtended.insert(s);
+			for (Node x : s) {
+				pairs.push_back(make_pair(batch.size(), x));
+			}
+			batch.push_back(s);
+		}
+		processInParallel(batch, pairs);
+		for (const MinimalSeparator& s : batch) {
+			if (maxSize < 0 || (int)s.size() <= maxSize) {
+				separatorsProcessed.push_back(s);
+			}
+		}
+		return;
 	}
 	// Choose separator and transfer to list of returned
 	MinimalSeparator s = separatorsToExtend.pop();
 	separatorsExtended.insert(s);
 	// Process separator according to the generation phase
+	NodeBitset sNodes(graph.getNumberOfNodes(), s);
 	for (MinimalSeparator::iterator i = s.begin(); i != s.end(); ++i) {
 		Node x = *i;
-		set<Node> xNeighborsAndS = graph.getNeighbors(x);
-		xNeighborsAndS.insert(s.begin(),s.end());
-		vector<NodeSet> components = graph.getComponents(xNeighborsAndS);
+		NodeBitset xNeighborsAndS(sNodes);
+		xNeighborsAndS.insertAll(graph.getNeighbors(x));
+		graph.getComponents(xNeighborsAndS, components);
 		for (vector<NodeSet>::iterator j = components.begin(); j != components.end(); ++j) {
-			minimalSeparatorFound(graph.getNeighbors(*j));
+			graph.getNeighbors(*j, componentNeighbors);
+			minimalSeparatorFound(componentNeighbors);
 		}
 	}
+	if (maxSize < 0 || (int)s.size() <= maxSize) {
+		separatorsProcessed.push_back(s);
+	}
+}
+
+/*
+ * Returns a processed separator that was not returned yet.
+ */
+MinimalSeparator MinimalSeparatorsEnumerator::next() {
+	// Verify that there is another separator
+	if (!hasNext()) {
+		return MinimalSeparator();
+	}
+	MinimalSeparator s = separatorsProcessed.front();
+	separatorsProcessed.pop_front();
 	return s;
 }
 
+void MinimalSeparatorsEnumerator::save(CheckpointWriter& output) const {
+	separatorsToExtend.save(output);
+	separatorsExtended.save(output);
+	output.writeNumber(separatorsProcessed.size());
+	for (const MinimalSeparator& s : separatorsProcessed) {
+		output.writeSortedNumbers(s.begin(), s.end(), s.size());
+	}
+}
+
+void MinimalSeparatorsEnumerator::load(CheckpointReader& input) {
+	separatorsToExtend.load(input);
+	separatorsExtended.load(input);
+	separatorsProcessed.clear();
+	uint64_t numberOfProcessed = input.readNumber();
+	for (uint64_t i = 0; i < numberOfProcessed && input.isValid(); i++) {
+		MinimalSeparator s;
+		input.readSortedNumbers<Node>(s);
+		separatorsProcessed.push_back(s);
+	}
+}
+
 } /* namespace tdenum */
@@ -2,8 +2,12 @@
 #define MINIMALSEPARATORSENUMERATOR_H_
 
 #include "Graph.h"
+#include "CompactGraph.h"
 #include "SeparatorsScorer.h"
 #include "DataStructures.h"
+#include "NodeBitset.h"
+#include "ThreadPool.h"
+#include <deque>
 
 namespace tdenum {
 
@@ -13,20 +17,64 @@ namespace tdenum {
  * Implementing the paper:
  * Generating all the minimal separators of a graph.
  * A. Berry, J. P. Bordat, and O. Cogis, 1999.
+ *
+ * With more than one thread, the separators are processed in batches: the
+ * best scored separators in the queue are processed in parallel, and then
+ * returned one by one. The priorities are then respected between batches only,
+ * and the order is the same for any number of threads above one.
+ *
+ * Optionally, only the separators up to a given size are returned. The larger
+ * separators are still processed, since the smaller ones may only be found
+ * through them, but they are not returned.
  */
 class MinimalSeparatorsEnumerator {
-	Graph graph;
+	CompactGraph graph;
 	SeparatorsScorer scorer;
 	WeightedNodeSetQueue separatorsToExtend;
 	NodeSetSet separatorsExtended;
+	// Buffers reused between calls to next
+	vector<NodeSet> components;
+	NodeSet componentNeighbors;
+	int numberOfThreads;
+	int maxSize;
+	// The separators that were processed and not returned yet
+	deque<MinimalSeparator> separatorsProcessed;
+	// The threads of the parallel mode, which live as long as the enumerator
+	ThreadPool threads;
+	// The buffers of every thread in the parallel mode, reused between batches
+	struct ThreadBuffers {
+		NodeBitset removedNodes;
+		vector<NodeSet> components;
+		NodeSet componentNeighbors;
+		// The new separators, by the pair and the position they were found in
+		vector< pair< pair<size_t,int>, MinimalSeparator > > newSeparators;
+	};
+	vector<ThreadBuffers> threadBuffers;
 	void minimalSeparatorFound(const MinimalSeparator& s);
+	// Processes the next separator in the queue, or the next batch of
+	// separators in the parallel mode, and keeps those to be returned
+	void processNext();
+	// Finds the separators N(C) for the components C obtained by removing
+	// S and N[x], for every pair (S,x) of the base set and a node, and adds
+	// the new ones to the queue in the order of the pairs. The pairs are
+	// divided between the threads, which only read the queue and the
+	// processed separators.
+	void processInParallel(const vector<MinimalSeparator>& bases,
+			const vector< pair<int,Node> >& pairs);
 public:
-	// Initialization
-	MinimalSeparatorsEnumerator(const Graph& g, SeparatorsScoringCriterion c);
+	// Initialization. Only the separators with at most maxSize nodes are
+	// returned, or all of them if it is negative.
+	MinimalSeparatorsEnumerator(const Graph& g, SeparatorsScoringCriterion c,
+			int numberOfThreads = 1, int maxSize = -1);
 	// Checks whether there is another minimal separator
 	bool hasNext();
 	// Returns another minimal separator
 	MinimalSeparator next();
+	// Writes the state of the enumeration
+	void save(CheckpointWriter& output) const;
+	// Continues the enumeration from a saved state, of an enumerator of the
+	// same graph with the same parameters
+	void load(CheckpointReader& input);
 };
 
 } /* namespace tdenum */
@@ -8,33 +8,140 @@ namespace tdenum {
  */
 MinimalTriangulationsEnumerator::MinimalTriangulationsEnumerator(
 			const Graph& g, TriangulationScoringCriterion triC,
-			SeparatorsScoringCriterion sepC, TriangulationAlgorithm heuristic) :
-		graph(g), separatorGraph(graph, sepC), triangulator(heuristic),
-		triExtender(graph, triangulator), sepExtender(graph), scorer(graph, triC),
-		setsEnumerator(separatorGraph, triExtender, scorer) {
+			SeparatorsScoringCriterion sepC, TriangulationAlgorithm heuristic,
+			int separatorThreads, int maxWidth, size_t cacheBytes,
+			int extensionThreads, int enumerationThreads, const string& externalDirectory,
+			int extensionCacheSize) :
+		graph(g), maxWidth(maxWidth),
+		separatorGraph(graph, pool, sepC, separatorThreads, maxWidth, cacheBytes),
+		triangulator(heuristic),
+		triExtender(graph, pool, triangulator), sepExtender(graph, pool), scorer(graph, pool, triC),
+		setsEnumerator(NULL), parallelSetsEnumerator(NULL), nextReady(false) {
+	if (enumerationThreads > 1) {
+		// The same extender as setsEnumerator, whose assignment does not copy
+		parallelSetsEnumerator = new ParallelMaximalIndependentSetsEnumerator<SeparatorId>(
+				separatorGraph, triExtender, enumerationThreads, extensionCacheSize);
+		return;
+	}
+	setsEnumerator = new MaximalIndependentSetsEnumerator<SeparatorId>(separatorGraph,
+			triExtender, scorer, extensionThreads, externalDirectory, extensionCacheSize);
 	if (heuristic == SEPARATORS) {
-		setsEnumerator = MaximalIndependentSetsEnumerator<MinimalSeparator>(
-				separatorGraph, sepExtender, scorer);
+		*setsEnumerator = MaximalIndependentSetsEnumerator<SeparatorId>(
+				separatorGraph, sepExtender, scorer, extensionThreads, externalDirectory,
+				extensionCacheSize);
 	}
 }
 
+MinimalTriangulationsEnumerator::~MinimalTriangulationsEnumerator() {
+	delete parallelSetsEnumerator;
+	delete setsEnumerator;
+}
+
 /*
  * Checks whether there is another minimal triangulation
  */
 bool MinimalTriangulationsEnumerator::hasNext(){
-	return setsEnumerator.hasNext();
+	while (!nextReady && (parallelSetsEnumerator ?
+			parallelSetsEnumerator->hasNext() : setsEnumerator->hasNext())) {
+		set<SeparatorId> separators = parallelSetsEnumerator ?
+				parallelSetsEnumerator->next() : setsEnumerator->next();
+		if (!hasSmallSeparators(separators)) {
+			continue;
+		}
+		nextTriangulation = Converter::minimalSeparatorsToTriangulation(graph, pool, separators);
+		nextReady = maxWidth < 0 || nextTriangulation.getTreeWidth() <= maxWidth;
+	}
+	return nextReady;
 }
 
 /*
  * Returns another minimal triangulation
  */
 ChordalGraph MinimalTriangulationsEnumerator::next() {
-	return Converter::minimalSeparatorsToTriangulation(graph, setsEnumerator.next());
+	if (!hasNext()) {
+		return ChordalGraph(graph);
+	}
+	nextReady = false;
+	return nextTriangulation;
+}
+
+/*
+ * The workers of the parallel engine may still use the separator graph after
+ * the enumeration is stopped.
+ */
+unique_lock<mutex> MinimalTriangulationsEnumerator::lockSeparatorGraph() const {
+	if (parallelSetsEnumerator == NULL) {
+		return unique_lock<mutex>();
+	}
+	return parallelSetsEnumerator->lockGraph();
+}
+
+/*
+ * The pool is written first, since the ids in the rest of the state refer to it.
+ */
+void MinimalTriangulationsEnumerator::save(CheckpointWriter& output) const {
+	pool.save(output);
+	separatorGraph.save(output);
+	triExtender.save(output);
+	scorer.save(output);
+	setsEnumerator->save(output);
+}
+
+void MinimalTriangulationsEnumerator::load(CheckpointReader& input) {
+	pool.load(input);
+	separatorGraph.load(input);
+	triExtender.load(input);
+	scorer.load(input);
+	setsEnumerator->load(input);
+	nextReady = false;
+}
+
+bool MinimalTriangulationsEnumerator::hasSmallSeparators(const set<SeparatorId>& s) const {
+	if (maxWidth < 0) {
+		return true;
+	}
+	for (SeparatorId id : s) {
+		if (pool.get(id).size() > maxWidth) {
+			return false;
+		}
+	}
+	return true;
 }
 
 int MinimalTriangulationsEnumerator::getNumberOfMinimalSeperatorsGenerated() {
+	unique_lock<mutex> graphGuard = lockSeparatorGraph();
 	return separatorGraph.getNumberOfNodesGenerated();
 }
 
+long long MinimalTriangulationsEnumerator::getNumberOfCacheHits() const {
+	return separatorGraph.getNumberOfCacheHits();
+}
+
+long long MinimalTriangulationsEnumerator::getNumberOfCacheMisses() const {
+	return separatorGraph.getNumberOfCacheMisses();
+}
+
+long long MinimalTriangulationsEnumerator::getNumberOfExtensionCacheHits() const {
+	return parallelSetsEnumerator ? parallelSetsEnumerator->getExtensionCacheHits() :
+			setsEnumerator->getExtensionCacheHits();
+}
+
+long long MinimalTriangulationsEnumerator::getNumberOfExtensionCacheMisses() const {
+	return parallelSetsEnumerator ? parallelSetsEnumerator->getExtensionCacheMisses() :
+			setsEnumerator->getExtensionCacheMisses();
+}
+
+long long MinimalTriangulationsEnumerator::getNumberOfSkippedExtensions() const {
+	return parallelSetsEnumerator ? parallelSetsEnumerator->getExtensionsSkipped() :
+			setsEnumerator->getExtensionsSkipped();
+}
+
+/*
+ * The parallel engine keeps the sets in memory, so it cannot fail.
+ */
+bool MinimalTriangulationsEnumerator::isValid() const {
+	return parallelSetsEnumerator != NULL || setsEnumerator->isValid();
+}
+
 } /* namespace tdenum */
 
@@ -6,31 +6,91 @@
 #include "IndSetExtByTriangulation.h"
 #include "IndSetExtBySeparators.h"
 #include "MaximalIndependentSetsEnumerator.h"
+#include "ParallelMaximalIndependentSetsEnumerator.h"
 #include "IndSetScorerByTriangulation.h"
 
 namespace tdenum {
 
 /**
- * Enumerates the minimal triangulations of a graph
+ * Enumerates the minimal triangulations of a graph, optionally only those of
+ * width at most a given bound.
+ *
+ * Every minimal separator of a triangulation of width at most k has at most k
+ * nodes, so the separator graph is restricted to these separators. The
+ * maximal independent sets are still extended with all the separators, and
+ * the ones whose triangulations are too wide are skipped. Every set is
+ * reached by extending in the direction of its own separators, so no
+ * triangulation of width at most k is missed.
+ *
+ * With more than one thread, the sets are enumerated by the parallel engine,
+ * and the triangulations are returned in the order they are found rather
+ * than by their scores.
  */
 class MinimalTriangulationsEnumerator {
 	Graph graph;
+	int maxWidth;
+	// The minimal separators are referred to by their ids in the pool
+	SeparatorPool pool;
 	SeparatorGraph separatorGraph;
 	MinimalTriangulator triangulator;
 	IndSetExtByTriangulation triExtender;
 	IndSetExtBySeparators sepExtender;
 	IndSetScorerByTriangulation scorer;
-	MaximalIndependentSetsEnumerator<MinimalSeparator> setsEnumerator;
+	// The sequential engine, or NULL if the parallel engine is used
+	MaximalIndependentSetsEnumerator<SeparatorId>* setsEnumerator;
+	// The parallel engine, or NULL if the sets are enumerated by setsEnumerator
+	ParallelMaximalIndependentSetsEnumerator<SeparatorId>* parallelSetsEnumerator;
+	ChordalGraph nextTriangulation;
+	bool nextReady;
+	// Returns whether the set may form a triangulation of width at most maxWidth
+	bool hasSmallSeparators(const set<SeparatorId>& s) const;
+	// Returns a lock under which the separator graph is not used by other threads
+	unique_lock<mutex> lockSeparatorGraph() const;
+
+	MinimalTriangulationsEnumerator(const MinimalTriangulationsEnumerator&);
+	MinimalTriangulationsEnumerator& operator=(const MinimalTriangulationsEnumerator&);
 public:
-	// initialization
+	// initialization, the minimal separators are generated with the given number
+	// of threads. Only triangulations of width at most maxWidth are enumerated,
+	// or all of them if it is negative. The components maps of the separators
+	// are cached within the given number of bytes. The sets of separators are
+	// extended with the given number of threads. If a directory is given, the
+	// sets of separators are kept in files in it. The extensions of at most
+	// the given number of sets are cached. With more than one enumeration
+	// thread, the parallel engine is used instead, which only uses the
+	// extension cache of these options and keeps the sets in memory.
 	MinimalTriangulationsEnumerator(const Graph& g, TriangulationScoringCriterion triC,
-			SeparatorsScoringCriterion sepC, TriangulationAlgorithm heuristic);
+			SeparatorsScoringCriterion sepC, TriangulationAlgorithm heuristic,
+			int separatorThreads = 1, int maxWidth = -1,
+			size_t cacheBytes = DEFAULT_COMPONENT_MAP_CACHE_BYTES,
+			int extensionThreads = 1, int enumerationThreads = 1,
+			const string& externalDirectory = "",
+			int extensionCacheSize = DEFAULT_EXTENSION_CACHE_ENTRIES);
+	~MinimalTriangulationsEnumerator();
 	// Checks whether there is another minimal triangulation
 	bool hasNext();
 	// Returns another minimal triangulation
 	ChordalGraph next();
 	// Returns the number of minimal separators generated
 	int getNumberOfMinimalSeperatorsGenerated();
+	// Returns the numbers of hits and misses of the components maps cache
+	long long getNumberOfCacheHits() const;
+	long long getNumberOfCacheMisses() const;
+	// Returns the numbers of hits and misses of the extensions cache
+	long long getNumberOfExtensionCacheHits() const;
+	long long getNumberOfExtensionCacheMisses() const;
+	// Returns the number of extensions skipped since they could not give a new
+	// triangulation
+	long long getNumberOfSkippedExtensions() const;
+	// Returns whether the files of the sets could be used so far. Once they
+	// fail, no more triangulations are returned.
+	bool isValid() const;
+	// Writes the state of the enumeration. Called right after next, when no
+	// triangulation is waiting to be returned. Only supported with one thread.
+	void save(CheckpointWriter& output) const;
+	// Continues the enumeration from a saved state, of an enumerator of the
+	// same graph with the same parameters
+	void load(CheckpointReader& input);
 };
 
 } /* namespace tdenum */
@@ -1,48 +1,77 @@
 #include "MinimalTriangulator.h"
 #include "DataStructures.h"
-#include <map>
+#include "NodeBitset.h"
+#include "DenseGraph.h"
 #include <algorithm>
 #include <iterator>
+#include <climits>
 
 namespace tdenum {
 
-MinimalTriangulator::MinimalTriangulator(TriangulationAlgorithm h) : heuristic(h), time(0) {}
+MinimalTriangulator::MinimalTriangulator(TriangulationAlgorithm h) : heuristic(h), time(0),
+		searchNumber(0) {}
+
+MinimalTriangulator::MinimalTriangulator(const MinimalTriangulator& other) :
+		heuristic(other.heuristic), time(other.time), searchNumber(0) {}
+
+MinimalTriangulator& MinimalTriangulator::operator=(const MinimalTriangulator& other) {
+	heuristic = other.heuristic;
+	time = other.time;
+	return *this;
+}
 
 // implementing MSC-M algorithm
-ChordalGraph getMinimalTriangulationUsingMSCM(const Graph& g) {
+// Every node popped starts a search of the nodes reachable through nodes of
+// smaller weights. The reached nodes are kept in buckets by the largest weight
+// on the path reaching them, which are processed in increasing order, so
+// every search takes O(m) time.
+template<class G, class Triangulation>
+Triangulation MinimalTriangulator::getMinimalTriangulationUsingMCSM(const G& g) {
 	// initialize structures
-	ChordalGraph triangulation(g); // holds the result
-	IncreasingWeightNodeQueue queue(g.getNumberOfNodes());
-	vector<bool> handled (g.getNumberOfNodes(), false);
+	Triangulation triangulation(g); // holds the result
+	int numberOfNodes = g.getNumberOfNodes();
+	queue.reset(numberOfNodes);
+	handled.assign(numberOfNodes, false);
+	if ((int)reachedBySearch.size() < numberOfNodes) {
+		reachedBySearch.resize(numberOfNodes, 0);
+	}
+	if ((int)reachedByMaxWeight.size() < numberOfNodes) {
+		reachedByMaxWeight.resize(numberOfNodes);
+	}
 	// start search
 	while (!queue.isEmpty()) {
 		// Pop node from queue
 		Node v = queue.pop();
 		handled[v] = true;
+		if (searchNumber == INT_MAX) {
+			fill(reachedBySearch.begin(), reachedBySearch.end(), 0);
+			searchNumber = 0;
+		}
+		searchNumber++;
 		// Find nodes to update
-		NodeSet nodesToUpdate;
-		vector<bool> reached(g.getNumberOfNodes(), false);
-		vector<NodeSet> reachedByMaxWeight(g.getNumberOfNodes(), vector<Node>());
-		for (set<Node>::iterator i=g.getNeighbors(v).begin(); i!=g.getNeighbors(v).end(); ++i) {
-			Node u = *i;
+		nodesToUpdate.clear();
+		int maxBucket = -1;
+		for (Node u : g.getNeighbors(v)) {
 			if (!handled[u]) {
 				nodesToUpdate.push_back(u);
-				reached[u] = true;
+				reachedBySearch[u] = searchNumber;
 				reachedByMaxWeight[queue.getWeight(u)].push_back(u);
+				maxBucket = max(maxBucket, queue.getWeight(u));
 			}
 		}
-		for (int maxWeight=0; maxWeight<g.getNumberOfNodes(); maxWeight++) {
+		for (int maxWeight=0; maxWeight<=maxBucket; maxWeight++) {
 			while (!reachedByMaxWeight[maxWeight].empty()) {
 				Node w = reachedByMaxWeight[maxWeight].back();
 				reachedByMaxWeight[maxWeight].pop_back();
-				for (set<Node>::iterator i=g.getNeighbors(w).begin(); i!=g.getNeighbors(w).end(); ++i) {
-					Node u = *i;
-					if (!handled[u] && !reached[u]) {
+				for (Node u : g.getNeighbors(w)) {
+					if (!handled[u] && reachedBySearch[u] != searchNumber) {
 						if (queue.getWeight(u) > maxWeight) {
 							nodesToUpdate.push_back(u);
 						}
-						reached[u] = true;
-						reachedByMaxWeight[max(queue.getWeight(u), maxWeight)].push_back(u);
+						reachedBySearch[u] = searchNumber;
+						int bucket = max(queue.getWeight(u), maxWeight);
+						reachedByMaxWeight[bucket].push_back(u);
+						maxBucket = max(maxBucket, bucket);
 					}
 				}
 			}
@@ -58,32 +87,133 @@ ChordalGraph getMinimalTriangulationUsingMSCM(const Graph& g) {
 }
 
 
-int getFill(const Graph& g, Node v) {
-	const set<Node>& neighborsSet = g.getNeighbors(v);
+// The fills are kept in rows of bits for graphs of at most this many nodes,
+// which take at most 8 MB, and are otherwise counted when a node is scored
+const int MAX_NODES_FOR_FILL_ROWS = 8192;
+
+// Returns the fill of v, the number of pairs of its neighbors that are not
+// neighbors, in O(n) memory and the sum of the degrees of its neighbors
+template<class G>
+int getFill(const G& g, Node v) {
+	TraversalWorkspace& neighbors = TraversalWorkspace::get(g.getNumberOfNodes());
+	for (Node u : g.getNeighbors(v)) {
+		neighbors.mark(u);
+	}
+	int degree = g.getNeighbors(v).size();
 	int twiceFillEdges = 0;
-	// for every node in the neighborhood, add the number of non-neighbors
-	for (set<Node>::iterator it=neighborsSet.begin(); it!=neighborsSet.end(); ++it) {
-		vector<bool> notNeighborsOfCurrentNode = g.getNeighborsMap(v);
-		notNeighborsOfCurrentNode[*it] = false;
-		const set<Node>& neighborsOfCurrentNode = g.getNeighbors(*it);
-		for (set<Node>::iterator jt=neighborsOfCurrentNode.begin(); jt!=neighborsOfCurrentNode.end(); ++jt) {
-			notNeighborsOfCurrentNode[*jt] = false;
-		}
-		for (int i=0; i<g.getNumberOfNodes(); i++) {
-			if (notNeighborsOfCurrentNode[i]) {
-				twiceFillEdges++;
+	// every neighbor misses the other neighbors that are not its neighbors
+	for (Node u : g.getNeighbors(v)) {
+		int commonNeighbors = 0;
+		for (Node w : g.getNeighbors(u)) {
+			if (neighbors.isMarked(w)) {
+				commonNeighbors++;
 			}
 		}
+		twiceFillEdges += degree - 1 - commonNeighbors;
 	}
 	return twiceFillEdges/2;
 }
 
+// The fill of every node, kept up to date as edges are added. The neighbors are kept as
+// rows of bits, so the common neighbors of the ends of a new edge are found
+// 64 nodes at a time, and an edge costs O(n/64) plus its common neighbors.
+class FillCounts {
+	vector<NodeBitset>& rows;
+	vector<int> degrees;
+	vector<int> fills;
+public:
+	// Counts the fills of the graph, using the given rows as a buffer
+	template<class G>
+	FillCounts(const G& g, vector<NodeBitset>& rows);
+	int getFill(Node v) const { return fills[v]; }
+	bool areNeighbors(Node u, Node v) const { return rows[u].contains(v); }
+	// Updates the fills for a new edge between nodes that are not neighbors:
+	// it is missing from the neighborhoods of their common neighbors, and each
+	// of its ends misses it from the other neighbors of the other end
+	void addEdge(Node u, Node v);
+};
+
+// Stores the neighbors of every node of g in its row
+template<class G>
+void copyNeighborRows(const G& g, vector<NodeBitset>& rows) {
+	for (Node v=0; v<g.getNumberOfNodes(); v++) {
+		for (Node u : g.getNeighbors(v)) {
+			rows[v].insert(u);
+		}
+	}
+}
+
+// Copies the rows of the dense base graph a word at a time if there is one,
+// so only the fill neighbors are inserted one at a time
+void copyNeighborRows(const SaturatedGraph& g, vector<NodeBitset>& rows) {
+	const DenseGraph* denseBase = g.getDenseBase();
+	if (!denseBase) {
+		copyNeighborRows<SaturatedGraph>(g, rows);
+		return;
+	}
+	for (Node v=0; v<g.getNumberOfNodes(); v++) {
+		bitsetUnite(rows[v].getWords(), denseBase->getRow(v), denseBase->getNumberOfWords());
+		rows[v].insertAll(g.getFillNeighbors(v));
+	}
+}
+
+template<class G>
+FillCounts::FillCounts(const G& g, vector<NodeBitset>& r) : rows(r),
+		degrees(g.getNumberOfNodes(), 0), fills(g.getNumberOfNodes(), 0) {
+	int numberOfNodes = g.getNumberOfNodes();
+	if ((int)rows.size() < numberOfNodes) {
+		rows.resize(numberOfNodes);
+	}
+	for (Node v=0; v<numberOfNodes; v++) {
+		rows[v].resize(numberOfNodes);
+		rows[v].clear();
+	}
+	copyNeighborRows(g, rows);
+	for (Node v=0; v<numberOfNodes; v++) {
+		degrees[v] = rows[v].size();
+	}
+	// every neighbor misses the other neighbors that are not its neighbors
+	for (Node v=0; v<numberOfNodes; v++) {
+		const uint64_t* words = rows[v].getWords();
+		int twiceFillEdges = 0;
+		for (int i=0; i<rows[v].getNumberOfWords(); i++) {
+			for (uint64_t word = words[i]; word != 0; word &= word - 1) {
+				Node u = i*64 + __builtin_ctzll(word);
+				twiceFillEdges += degrees[v] - 1 - rows[v].intersectionSize(rows[u]);
+			}
+		}
+		fills[v] = twiceFillEdges/2;
+	}
+}
+
+void FillCounts::addEdge(Node u, Node v) {
+	const uint64_t* uWords = rows[u].getWords();
+	const uint64_t* vWords = rows[v].getWords();
+	int commonNeighbors = 0;
+	for (int i=0; i<rows[u].getNumberOfWords(); i++) {
+		for (uint64_t word = uWords[i] & vWords[i]; word != 0; word &= word - 1) {
+			fills[i*64 + __builtin_ctzll(word)]--;
+			commonNeighbors++;
+		}
+	}
+	fills[u] += degrees[u] - commonNeighbors;
+	fills[v] += degrees[v] - commonNeighbors;
+	rows[u].insert(v);
+	rows[v].insert(u);
+	degrees[u]++;
+	degrees[v]++;
+}
+
 // Returns the minimal separators included in the neighborhood of v
 // The substars are saved in a data structure (set<NodeSet>) different than the
 // one described in the paper. Its theoretical complexity can be improved.
-set<NodeSet> getSubstars(const Graph& g, const Graph& gi, Node v) {
-	set<Node> removedNodes = gi.getNeighbors(v);
-	removedNodes.insert(v);
+template<class G>
+set<NodeSet> getSubstars(const G& g, const G& gi, Node v) {
+	NodeSet removedNodes;
+	for (Node u : gi.getNeighbors(v)) {
+		removedNodes.push_back(u);
+	}
+	removedNodes.insert(lower_bound(removedNodes.begin(), removedNodes.end(), v), v);
 	vector<NodeSet> components = g.getComponents(removedNodes);
 	set<NodeSet> substars;
 	for (vector<NodeSet>::iterator it=components.begin(); it!=components.end(); ++it) {
@@ -94,25 +224,45 @@ set<NodeSet> getSubstars(const Graph& g, const Graph& gi, Node v) {
 
 // Saturates the minimal separators included in the neighborhood of v
 // g is the original graph, and gi is the graph in the last phase.
-void makeNodeLBSimplicial(const Graph& g, Graph& gi, Node v) {
+// The fills are updated for the new edges if given.
+template<class G>
+void makeNodeLBSimplicial(const G& g, G& gi, Node v, FillCounts* fills = NULL) {
 	set<NodeSet> substars =  getSubstars(g, gi, v);
-	gi.saturateNodeSets(substars);
+	if (!fills) {
+		gi.saturateNodeSets(substars);
+		return;
+	}
+	for (const NodeSet& substar : substars) {
+		for (unsigned int i=0; i<substar.size(); i++) {
+			for (unsigned int j=0; j<i; j++) {
+				if (!fills->areNeighbors(substar[j], substar[i])) {
+					fills->addEdge(substar[j], substar[i]);
+					gi.addEdge(substar[j], substar[i]);
+				}
+			}
+		}
+	}
 }
 
+// The fills are given for the fill heuristics on small graphs, and are
+// otherwise counted for every score
+template<class G>
 class NodeQueue {
 	set< pair<int,Node> > queue;
-	const Graph& graph;
+	const G& graph;
 	TriangulationAlgorithm heuristic;
+	const FillCounts* fills;
 	int score(Node v) {
 		if (heuristic == MIN_DEGREE_LB_TRIANG || heuristic == INITIAL_DEGREE_LB_TRIANG) {
 			return graph.getNeighbors(v).size();
 		} else if (heuristic == MIN_FILL_LB_TRIANG || heuristic == INITIAL_FILL_LB_TRIANG || heuristic == COMBINED) {
-			return getFill(graph, v);
+			return fills ? fills->getFill(v) : getFill(graph, v);
 		}
 		return 0;
 	}
 public:
-	NodeQueue(const Graph& g, TriangulationAlgorithm h) : graph(g), heuristic(h) {
+	NodeQueue(const G& g, TriangulationAlgorithm h, const FillCounts* f) :
+			graph(g), heuristic(h), fills(f) {
 		for (Node v=0; v<g.getNumberOfNodes(); v++) {
 			queue.insert(make_pair(score(v), v));
 		}
@@ -140,14 +290,27 @@ public:
 };
 
 
-ChordalGraph getMinimalTriangulationUsingLBTriang(const Graph& g, TriangulationAlgorithm heuristic) {
-	Graph result(g);
+// The rows of the fill heuristics are kept in fillRows between triangulations.
+// The fills are only kept up to date for the heuristics that score again.
+// Larger graphs use no rows, and the fills are counted when they are scored.
+template<class G>
+G getMinimalTriangulationUsingLBTriang(const G& g, TriangulationAlgorithm heuristic,
+		vector<NodeBitset>& fillRows) {
+	G result(g);
 	if (heuristic == LB_TRIANG) {
 		for (Node v=0; v<g.getNumberOfNodes(); v++) {
 			makeNodeLBSimplicial(g, result, v);
 		}
+	} else if ((heuristic == MIN_FILL_LB_TRIANG || heuristic == INITIAL_FILL_LB_TRIANG ||
+			heuristic == COMBINED) && g.getNumberOfNodes() <= MAX_NODES_FOR_FILL_ROWS) {
+		FillCounts fills(result, fillRows);
+		NodeQueue<G> queue(result, heuristic, &fills);
+		bool isRescored = heuristic != INITIAL_FILL_LB_TRIANG;
+		while (!queue.isEmpty()) {
+			makeNodeLBSimplicial(g, result, queue.pop(), isRescored ? &fills : NULL);
+		}
 	} else {
-		NodeQueue queue(result, heuristic);
+		NodeQueue<G> queue(result, heuristic, NULL);
 		while (!queue.isEmpty()) {
 			makeNodeLBSimplicial(g, result, queue.pop());
 		}
@@ -159,9 +322,25 @@ ChordalGraph getMinimalTriangulationUsingLBTriang(const Graph& g, TriangulationA
 ChordalGraph MinimalTriangulator::triangulate(const Graph& g) {
 	time++;
 	if (heuristic == MCS_M || (heuristic == COMBINED && time % 2 == 0)) {
-		return getMinimalTriangulationUsingMSCM(g);
+		return getMinimalTriangulationUsingMCSM<Graph, ChordalGraph>(g);
+	}
+	return getMinimalTriangulationUsingLBTriang(g, heuristic, fillRows);
+}
+
+SaturatedGraph MinimalTriangulator::triangulate(const SaturatedGraph& g) {
+	time++;
+	if (heuristic == MCS_M || (heuristic == COMBINED && time % 2 == 0)) {
+		return getMinimalTriangulationUsingMCSM<SaturatedGraph, SaturatedGraph>(g);
 	}
-	return getMinimalTriangulationUsingLBTriang(g, heuristic);
+	return getMinimalTriangulationUsingLBTriang(g, heuristic, fillRows);
+}
+
+void MinimalTriangulator::save(CheckpointWriter& output) const {
+	output.writeNumber(time);
+}
+
+void MinimalTriangulator::load(CheckpointReader& input) {
+	time = input.readNumber();
 }
 
 
@@ -2,6 +2,10 @@
 #define MINIMALTRIANGULATOR_H_
 
 #include "ChordalGraph.h"
+#include "SaturatedGraph.h"
+#include "Checkpoint.h"
+#include "DataStructures.h"
+#include "NodeBitset.h"
 
 namespace tdenum {
 
@@ -11,13 +15,43 @@ enum TriangulationAlgorithm { MCS_M, MIN_FILL_LB_TRIANG, INITIAL_FILL_LB_TRIANG,
 /**
  * Calculates a minimal triangulation of the graph
  * Implements MSC-M or LB-Triang with min-fill or min-dgree heuristics
+ *
+ * The buffers of MCS-M are kept between triangulations, so a triangulation
+ * only allocates its result. The nodes reached by every search are marked
+ * with the number of the search, so the marks are not cleared. The fill
+ * heuristics of LB-Triang keep the fills of the nodes up to date as edges are
+ * added, in rows of bits that are also kept between triangulations, for
+ * graphs small enough for the rows to take a few megabytes.
  */
 class MinimalTriangulator {
 	TriangulationAlgorithm heuristic;
 	int time;
+	// Buffers of MCS-M
+	IncreasingWeightNodeQueue queue;
+	vector<bool> handled;
+	vector<int> reachedBySearch;
+	int searchNumber;
+	vector<NodeSet> reachedByMaxWeight;
+	NodeSet nodesToUpdate;
+	// Buffer of the fill heuristics
+	vector<NodeBitset> fillRows;
+	// G is the type of the input graph and Triangulation the type of the
+	// result, which is initialized as a copy of the input
+	template<class G, class Triangulation>
+	Triangulation getMinimalTriangulationUsingMCSM(const G& g);
 public:
 	MinimalTriangulator(TriangulationAlgorithm h);
+	// A copy has the same algorithm and number of triangulations, and its own
+	// buffers, which start empty
+	MinimalTriangulator(const MinimalTriangulator& other);
+	MinimalTriangulator& operator=(const MinimalTriangulator& other);
 	ChordalGraph triangulate(const Graph& g);
+	// Returns the triangulation as fill edges added to the input's base graph
+	SaturatedGraph triangulate(const SaturatedGraph& g);
+	// Writes and restores the number of triangulations, which selects the
+	// algorithm of the combined heuristic
+	void save(CheckpointWriter& output) const;
+	void load(CheckpointReader& input);
 };
 
 } /* namespace tdenum */
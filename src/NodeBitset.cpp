@@ -0,0 +1,251 @@
+#include "NodeBitset.h"
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace tdenum {
+
+namespace {
+
+/*
+ * Every kernel handles as many words as possible with vector instructions and
+ * the remainder one word at a time.
+ */
+#if defined(__AVX2__)
+
+const int WORDS_PER_VECTOR = 4;
+
+inline __m256i loadWords(const uint64_t* p) {
+	return _mm256_loadu_si256((const __m256i*)p);
+}
+
+inline void storeWords(uint64_t* p, __m256i v) {
+	_mm256_storeu_si256((__m256i*)p, v);
+}
+
+inline bool isZero(__m256i v) {
+	return _mm256_testz_si256(v, v);
+}
+
+#define VECTOR_AND _mm256_and_si256
+#define VECTOR_OR _mm256_or_si256
+#define VECTOR_ANDNOT _mm256_andnot_si256
+
+#elif defined(__SSE2__)
+
+const int WORDS_PER_VECTOR = 2;
+
+inline __m128i loadWords(const uint64_t* p) {
+	return _mm_loadu_si128((const __m128i*)p);
+}
+
+inline void storeWords(uint64_t* p, __m128i v) {
+	_mm_storeu_si128((__m128i*)p, v);
+}
+
+inline bool isZero(__m128i v) {
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) == 0xFFFF;
+}
+
+#define VECTOR_AND _mm_and_si128
+#define VECTOR_OR _mm_or_si128
+#define VECTOR_ANDNOT _mm_andnot_si128
+
+#else
+
+const int WORDS_PER_VECTOR = 0;
+
+#endif
+
+} /* anonymous namespace */
+
+void bitsetIntersect(uint64_t* target, const uint64_t* other, int numberOfWords) {
+	int i = 0;
+#if defined(VECTOR_AND)
+	for (; i + WORDS_PER_VECTOR <= numberOfWords; i += WORDS_PER_VECTOR) {
+		storeWords(target + i, VECTOR_AND(loadWords(target + i), loadWords(other + i)));
+	}
+#endif
+	for (; i < numberOfWords; i++) {
+		target[i] &= other[i];
+	}
+}
+
+void bitsetUnite(uint64_t* target, const uint64_t* other, int numberOfWords) {
+	int i = 0;
+#if defined(VECTOR_OR)
+	for (; i + WORDS_PER_VECTOR <= numberOfWords; i += WORDS_PER_VECTOR) {
+		storeWords(target + i, VECTOR_OR(loadWords(target + i), loadWords(other + i)));
+	}
+#endif
+	for (; i < numberOfWords; i++) {
+		target[i] |= other[i];
+	}
+}
+
+void bitsetSubtract(uint64_t* target, const uint64_t* other, int numberOfWords) {
+	int i = 0;
+#if defined(VECTOR_ANDNOT)
+	for (; i + WORDS_PER_VECTOR <= numberOfWords; i += WORDS_PER_VECTOR) {
+		// andnot negates its first operand
+		storeWords(target + i, VECTOR_ANDNOT(loadWords(other + i), loadWords(target + i)));
+	}
+#endif
+	for (; i < numberOfWords; i++) {
+		target[i] &= ~other[i];
+	}
+}
+
+int bitsetCount(const uint64_t* words, int numberOfWords) {
+	int count = 0;
+	for (int i = 0; i < numberOfWords; i++) {
+		count += __builtin_popcountll(words[i]);
+	}
+	return count;
+}
+
+int bitsetIntersectionCount(const uint64_t* a, const uint64_t* b, int numberOfWords) {
+	int count = 0;
+	for (int i = 0; i < numberOfWords; i++) {
+		count += __builtin_popcountll(a[i] & b[i]);
+	}
+	return count;
+}
+
+bool bitsetIsSubset(const uint64_t* a, const uint64_t* b, int numberOfWords) {
+	int i = 0;
+#if defined(VECTOR_ANDNOT)
+	for (; i + WORDS_PER_VECTOR <= numberOfWords; i += WORDS_PER_VECTOR) {
+		if (!isZero(VECTOR_ANDNOT(loadWords(b + i), loadWords(a + i)))) {
+			return false;
+		}
+	}
+#endif
+	for (; i < numberOfWords; i++) {
+		if (a[i] & ~b[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool bitsetIntersects(const uint64_t* a, const uint64_t* b, int numberOfWords) {
+	int i = 0;
+#if defined(VECTOR_AND)
+	for (; i + WORDS_PER_VECTOR <= numberOfWords; i += WORDS_PER_VECTOR) {
+		if (!isZero(VECTOR_AND(loadWords(a + i), loadWords(b + i)))) {
+			return true;
+		}
+	}
+#endif
+	for (; i < numberOfWords; i++) {
+		if (a[i] & b[i]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void bitsetAppendNodes(const uint64_t* words, int numberOfWords, NodeSet& result) {
+	for (int i = 0; i < numberOfWords; i++) {
+		uint64_t word = words[i];
+		while (word) {
+			result.push_back(i*64 + __builtin_ctzll(word));
+			word &= word - 1;
+		}
+	}
+}
+
+
+
+NodeBitset::NodeBitset() : capacity(0) {}
+
+NodeBitset::NodeBitset(int capacity) : capacity(capacity), words((capacity+63)/64, 0) {}
+
+NodeBitset::NodeBitset(int capacity, const NodeSet& nodes) :
+		capacity(capacity), words((capacity+63)/64, 0) {
+	insertAll(nodes);
+}
+
+void NodeBitset::resize(int newCapacity) {
+	words.resize((newCapacity+63)/64, 0);
+	if (newCapacity < capacity && newCapacity % 64 != 0) {
+		words.back() &= ((uint64_t)1 << (newCapacity % 64)) - 1;
+	}
+	capacity = newCapacity;
+}
+
+void NodeBitset::clear() {
+	fill(words.begin(), words.end(), 0);
+}
+
+int NodeBitset::size() const {
+	return bitsetCount(words.data(), words.size());
+}
+
+bool NodeBitset::isEmpty() const {
+	for (uint64_t word : words) {
+		if (word) {
+			return false;
+		}
+	}
+	return true;
+}
+
+NodeBitset& NodeBitset::intersectWith(const NodeBitset& other) {
+	bitsetIntersect(words.data(), other.words.data(), words.size());
+	return *this;
+}
+
+NodeBitset& NodeBitset::uniteWith(const NodeBitset& other) {
+	bitsetUnite(words.data(), other.words.data(), words.size());
+	return *this;
+}
+
+NodeBitset& NodeBitset::subtract(const NodeBitset& other) {
+	bitsetSubtract(words.data(), other.words.data(), words.size());
+	return *this;
+}
+
+int NodeBitset::intersectionSize(const NodeBitset& other) const {
+	return bitsetIntersectionCount(words.data(), other.words.data(), words.size());
+}
+
+bool NodeBitset::isSubsetOf(const NodeBitset& other) const {
+	return bitsetIsSubset(words.data(), other.words.data(), words.size());
+}
+
+bool NodeBitset::intersects(const NodeBitset& other) const {
+	return bitsetIntersects(words.data(), other.words.data(), words.size());
+}
+
+NodeSet NodeBitset::toNodeSet() const {
+	NodeSet nodes;
+	bitsetAppendNodes(words.data(), words.size(), nodes);
+	return nodes;
+}
+
+bool NodeBitset::operator==(const NodeBitset& other) const {
+	return capacity == other.capacity && words == other.words;
+}
+
+NodeBitset operator&(const NodeBitset& a, const NodeBitset& b) {
+	NodeBitset result(a);
+	return result.intersectWith(b);
+}
+
+NodeBitset operator|(const NodeBitset& a, const NodeBitset& b) {
+	NodeBitset result(a);
+	return result.uniteWith(b);
+}
+
+NodeBitset operator-(const NodeBitset& a, const NodeBitset& b) {
+	NodeBitset result(a);
+	return result.subtract(b);
+}
+
+} /* namespace tdenum */
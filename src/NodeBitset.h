@@ -0,0 +1,96 @@
+#ifndef NODEBITSET_H_
+#define NODEBITSET_H_
+
+#include "Graph.h"
+#include <stdint.h>
+
+namespace tdenum {
+
+/*
+ * Kernels over arrays of 64 bit words, used by NodeBitset and by code working
+ * on raw rows of bits. Use AVX2 or SSE2 when the compiler targets them.
+ */
+// target &= other
+void bitsetIntersect(uint64_t* target, const uint64_t* other, int numberOfWords);
+// target |= other
+void bitsetUnite(uint64_t* target, const uint64_t* other, int numberOfWords);
+// target &= ~other
+void bitsetSubtract(uint64_t* target, const uint64_t* other, int numberOfWords);
+// Returns the number of bits set
+int bitsetCount(const uint64_t* words, int numberOfWords);
+// Returns the number of bits set in both
+int bitsetIntersectionCount(const uint64_t* a, const uint64_t* b, int numberOfWords);
+// Returns whether every bit set in a is set in b
+bool bitsetIsSubset(const uint64_t* a, const uint64_t* b, int numberOfWords);
+// Returns whether some bit is set in both
+bool bitsetIntersects(const uint64_t* a, const uint64_t* b, int numberOfWords);
+// Appends the nodes whose bits are set, ascending, where bit 0 is node 0
+void bitsetAppendNodes(const uint64_t* words, int numberOfWords, NodeSet& result);
+
+/**
+ * A set of nodes out of 0...capacity-1, stored as a dynamic bitset.
+ * Membership is a single bit lookup and the set operations handle 64 nodes
+ * per word (or 256 with AVX2). Operations between two bitsets assume both
+ * have the same capacity.
+ */
+class NodeBitset {
+	int capacity;
+	vector<uint64_t> words;
+public:
+	// Constructs an empty set with capacity 0
+	NodeBitset();
+	// Constructs an empty set of nodes out of 0...capacity-1
+	NodeBitset(int capacity);
+	// Constructs the set of the given nodes out of 0...capacity-1
+	NodeBitset(int capacity, const NodeSet& nodes);
+	// Changes the capacity, dropping nodes that no longer fit
+	void resize(int capacity);
+	int getCapacity() const { return capacity; }
+
+	void insert(Node v) { words[v >> 6] |= (uint64_t)1 << (v & 63); }
+	void remove(Node v) { words[v >> 6] &= ~((uint64_t)1 << (v & 63)); }
+	bool contains(Node v) const { return (words[v >> 6] >> (v & 63)) & 1; }
+	// Adds all the given nodes
+	template<class Container>
+	void insertAll(const Container& nodes) {
+		for (Node v : nodes) {
+			insert(v);
+		}
+	}
+	// Removes all the nodes
+	void clear();
+	// Returns the number of nodes in the set
+	int size() const;
+	bool isEmpty() const;
+
+	// Keeps only the nodes that are also in other
+	NodeBitset& intersectWith(const NodeBitset& other);
+	// Adds the nodes of other
+	NodeBitset& uniteWith(const NodeBitset& other);
+	// Removes the nodes of other
+	NodeBitset& subtract(const NodeBitset& other);
+	// Returns the number of nodes in both sets
+	int intersectionSize(const NodeBitset& other) const;
+	// Returns whether every node in this set is in other
+	bool isSubsetOf(const NodeBitset& other) const;
+	// Returns whether the sets share a node
+	bool intersects(const NodeBitset& other) const;
+
+	// Returns the nodes in the set, sorted ascending
+	NodeSet toNodeSet() const;
+	// Direct access to the words, for kernels working on raw rows
+	const uint64_t* getWords() const { return words.data(); }
+	uint64_t* getWords() { return words.data(); }
+	int getNumberOfWords() const { return words.size(); }
+
+	bool operator==(const NodeBitset& other) const;
+	bool operator!=(const NodeBitset& other) const { return !(*this == other); }
+};
+
+NodeBitset operator&(const NodeBitset& a, const NodeBitset& b);
+NodeBitset operator|(const NodeBitset& a, const NodeBitset& b);
+NodeBitset operator-(const NodeBitset& a, const NodeBitset& b);
+
+} /* namespace tdenum */
+
+#endif /* NODEBITSET_H_ */
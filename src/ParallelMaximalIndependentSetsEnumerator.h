@@ -0,0 +1,530 @@
+#ifndef PARALLELMAXIMALINDEPENDENTSETSENUMERATOR_H_
+#define PARALLELMAXIMALINDEPENDENTSETSENUMERATOR_H_
+
+#include "SuccinctGraphRepresentation.h"
+#include "IndependentSetExtender.h"
+#include "IndependentSetStore.h"
+#include "ExtensionCache.h"
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+
+namespace tdenum {
+
+/**
+ * Enumerates the maximal independent sets of a succinct graph representation,
+ * like MaximalIndependentSetsEnumerator, with several worker threads.
+ *
+ * Every set found has to be extended in the direction of every node. When a
+ * set is found, the pairs of it with the nodes generated so far are queued,
+ * and when a node is generated, the pairs of it with the sets found so far are
+ * queued, so every pair is queued once. Every worker has its own queue of such
+ * ranges of pairs, with its own lock, takes the last range of its queue, and
+ * when it is empty steals the first range of another queue. Pairs are taken
+ * one at a time, and the rest of the range is left to be stolen. When no
+ * pairs are left, a worker generates the next node.
+ *
+ * Every worker extends with its own copy of the extender. The nodes are
+ * generated by one worker at a time, and the non-neighbors are found by
+ * several workers at once if the graph supports it, and otherwise by one at a
+ * time. The sets found are stored once, in shards with their own locks. The
+ * sets are returned in the order they are found, which depends on the timing
+ * of the workers, and their scores are not used.
+ *
+ * A worker that finds no work waits until pairs are queued or a node may be
+ * generated, and only one waiting worker is woken at a time. A worker that
+ * takes a pair of a range with more pairs left wakes another.
+ *
+ * As in MaximalIndependentSetsEnumerator, a pair whose node is in its set,
+ * and a pair whose base set was already extended from the same range, are
+ * skipped. Every worker also keeps the handles of the extensions of its
+ * recent base sets in its own cache. Such an extension was already stored,
+ * so a base set found in the cache is not extended again.
+ */
+template<class T>
+class ParallelMaximalIndependentSetsEnumerator {
+	// The two hashes of the base sets extended from the pairs of a range,
+	// shared by the workers that take its pairs
+	struct BaseSetsExtended {
+		mutex lock;
+		set< pair<uint64_t,uint64_t> > hashes;
+	};
+	// A range of pairs of a set with nodes, or of a node with sets, by position
+	struct PairsRange {
+		bool isNode;
+		int index;
+		unsigned int begin;
+		unsigned int end;
+		shared_ptr<BaseSetsExtended> baseSets;
+	};
+	// The state of a worker. Its queue is shared with the workers that steal
+	// from it, its statistics are read by the enumerator, and the rest is used
+	// only by the worker.
+	struct Worker {
+		IndependentSetExtender<T>* extender;
+		ExtensionCache extensionCache;
+		mutex queueLock;
+		deque<PairsRange> queue;
+		atomic<long long> extensionCacheHits;
+		atomic<long long> extensionCacheMisses;
+		atomic<long long> extensionsSkipped;
+		Worker(IndependentSetExtender<T>* extender, int extensionCacheSize) :
+			extender(extender), extensionCache(extensionCacheSize),
+			extensionCacheHits(0), extensionCacheMisses(0), extensionsSkipped(0) {}
+	};
+	// How a worker handled a pair
+	enum PairOutcome {PAIR_SKIPPED, PAIR_IN_CACHE, PAIR_EXTENDED};
+	// The number of sets found and not yet returned, above which the workers wait
+	static const unsigned int MAX_PENDING_SETS_PER_THREAD = 1024;
+
+	// Input
+	SuccinctGraphRepresentation<T>& graph;
+	// The workers, where the first extends with the given extender and the
+	// others with its copies
+	vector<Worker*> workers;
+	vector<thread> threads;
+	ConcurrentIndependentSetStore<T> setsFound;
+
+	// The nodes generated, and the handles of the sets found, in the order
+	// they were added, which the ranges refer to by position. Read under the
+	// shared positionsLock, and added to under the exclusive one.
+	shared_mutex positionsLock;
+	vector<T> nodesGenerated;
+	vector<int> setHandles;
+
+	// State of the workers and of the results, guarded by lock
+	mutex lock;
+	// Wakes a worker waiting for work
+	condition_variable workAvailable;
+	// Wakes the enumerator waiting for a result
+	condition_variable resultAvailable;
+	// Wakes the workers waiting for the results to be returned
+	condition_variable resultTaken;
+	bool hasMoreNodes;
+	bool isGeneratingNode;
+	// The handles of the sets found and not yet returned
+	deque<int> pendingSets;
+	// Changed whenever pairs are queued or a node is generated, so a worker
+	// that found no work knows whether more came meanwhile. Read without lock.
+	atomic<long long> workVersion;
+	// The number of workers waiting for work. Read without lock.
+	atomic<int> idleWorkers;
+	bool isStarted;
+	bool isFinished;
+	atomic<bool> isStopping;
+
+	// Held while a node is generated, and while the graph is used if it does
+	// not support concurrent use
+	mutex graphLock;
+
+	// Takes the next pair for the given worker, with the base sets extended
+	// from its range, and returns false if there are none.
+	bool takePair(int worker, int& setHandle, T& node,
+			shared_ptr<BaseSetsExtended>& baseSets);
+	// Queues the range in the queue of the given worker, and wakes a waiting worker
+	void queueRange(int worker, const PairsRange& range);
+	// Wakes a waiting worker, if there is one, to look for work
+	void wakeWorker();
+	// Stores the set, queues its pairs and publishes it if it is new, and
+	// returns its handle. Waits while too many sets were not returned yet.
+	int newSetFound(int worker, const set<T>& s);
+	// Saves the extension of the set in the direction of the node to
+	// extension, unless the pair is skipped or its base set is in the cache
+	// of the worker. Saves the hashes of the base set.
+	PairOutcome extendPair(int worker, const set<T>& s, const T& node,
+			BaseSetsExtended& baseSets, pair<uint64_t,uint64_t>& hashes, set<T>& extension);
+	// Generates the next node and queues its pairs, unless there are no more
+	// nodes or another worker is generating one. Returns whether it did.
+	bool generateNode(int worker);
+	void runWorker(int worker);
+
+	ParallelMaximalIndependentSetsEnumerator(const ParallelMaximalIndependentSetsEnumerator&);
+	ParallelMaximalIndependentSetsEnumerator& operator=(const ParallelMaximalIndependentSetsEnumerator&);
+public:
+	/**
+	 * Initialization. Receives a succinct graph representation with an
+	 * independent set expansion. Uses the given number of workers if the
+	 * extender can be copied, and a single worker otherwise. The extensions of
+	 * at most the given number of base sets are cached, divided between the
+	 * workers. The workers start at the first call to hasNext.
+	 */
+	ParallelMaximalIndependentSetsEnumerator(SuccinctGraphRepresentation<T>& graph,
+			IndependentSetExtender<T>& extender, int numberOfThreads,
+			int extensionCacheSize = DEFAULT_EXTENSION_CACHE_ENTRIES);
+	// Stops the workers
+	~ParallelMaximalIndependentSetsEnumerator();
+	// Checks whether there is another maximal independent set, and waits for
+	// the workers to find it if needed
+	bool hasNext();
+	// Returns another maximal independent set
+	set<T> next();
+	// Returns a lock that keeps the workers from generating nodes, and from
+	// using the graph if it does not support concurrent use, while it is held
+	unique_lock<mutex> lockGraph();
+	// Returns the number of base sets found in the caches, and the number of
+	// extensions computed while the caches were used
+	long long getExtensionCacheHits();
+	long long getExtensionCacheMisses();
+	// Returns the number of pairs skipped without extending
+	long long getExtensionsSkipped();
+};
+
+
+/*
+ * Prefers the last range of the worker's own queue, and otherwise steals the
+ * first range of the next queue that is not empty. Only the lock of the queue
+ * is held while the pair is taken.
+ */
+template<class T>
+bool ParallelMaximalIndependentSetsEnumerator<T>::takePair(int worker,
+		int& setHandle, T& node, shared_ptr<BaseSetsExtended>& baseSets) {
+	PairsRange taken;
+	bool hasMorePairs = false;
+	bool isTaken = false;
+	for (unsigned int i = 0; i < workers.size() && !isTaken; i++) {
+		Worker& owner = *workers[(worker + i) % workers.size()];
+		lock_guard<mutex> queueGuard(owner.queueLock);
+		if (owner.queue.empty()) {
+			continue;
+		}
+		PairsRange& range = i == 0 ? owner.queue.back() : owner.queue.front();
+		taken = range;
+		range.begin++;
+		if (range.begin == range.end) {
+			if (i == 0) {
+				owner.queue.pop_back();
+			} else {
+				owner.queue.pop_front();
+			}
+		}
+		hasMorePairs = !owner.queue.empty();
+		isTaken = true;
+	}
+	if (!isTaken) {
+		return false;
+	}
+	if (hasMorePairs && idleWorkers > 0) {
+		wakeWorker();
+	}
+	shared_lock<shared_mutex> positionsGuard(positionsLock);
+	setHandle = taken.isNode ? setHandles[taken.begin] : taken.index;
+	node = nodesGenerated[taken.isNode ? taken.index : taken.begin];
+	baseSets = taken.baseSets;
+	return true;
+}
+
+
+/*
+ * The version is changed under lock, so a worker that is about to wait sees
+ * the change before it waits.
+ */
+template<class T>
+void ParallelMaximalIndependentSetsEnumerator<T>::wakeWorker() {
+	lock_guard<mutex> stateGuard(lock);
+	workVersion++;
+	workAvailable.notify_one();
+}
+
+
+template<class T>
+void ParallelMaximalIndependentSetsEnumerator<T>::queueRange(int worker,
+		const PairsRange& range) {
+	{
+		lock_guard<mutex> queueGuard(workers[worker]->queueLock);
+		workers[worker]->queue.push_back(range);
+	}
+	wakeWorker();
+}
+
+
+/*
+ * The set gets its position and the nodes it is paired with under the same
+ * exclusive lock that a new node gets its position and the sets it is paired
+ * with, so every pair is queued once. The set is copied from the store when it
+ * is returned, outside the lock.
+ */
+template<class T>
+int ParallelMaximalIndependentSetsEnumerator<T>::newSetFound(int worker,
+		const set<T>& s) {
+	bool isNew;
+	int handle = setsFound.insert(s, isNew);
+	if (!isNew) {
+		return handle;
+	}
+	unsigned int numberOfNodes;
+	{
+		unique_lock<shared_mutex> positionsGuard(positionsLock);
+		setHandles.push_back(handle);
+		numberOfNodes = nodesGenerated.size();
+	}
+	if (numberOfNodes > 0) {
+		PairsRange range = {false, handle, 0, numberOfNodes, make_shared<BaseSetsExtended>()};
+		queueRange(worker, range);
+	}
+	unique_lock<mutex> stateLock(lock);
+	pendingSets.push_back(handle);
+	resultAvailable.notify_one();
+	resultTaken.wait(stateLock, [&] { return isStopping ||
+			pendingSets.size() < MAX_PENDING_SETS_PER_THREAD * workers.size(); });
+	return handle;
+}
+
+
+/*
+ * A base set is marked as extended from the range before it is extended, so
+ * another worker that reaches it meanwhile skips it. The set extended to
+ * contains the base set, which is all that the other pair needs.
+ */
+template<class T>
+typename ParallelMaximalIndependentSetsEnumerator<T>::PairOutcome
+ParallelMaximalIndependentSetsEnumerator<T>::extendPair(int worker, const set<T>& s,
+		const T& node, BaseSetsExtended& baseSets, pair<uint64_t,uint64_t>& hashes,
+		set<T>& extension) {
+	if (s.find(node) != s.end()) {
+		return PAIR_SKIPPED;
+	}
+	set<T> baseNodes;
+	if (graph.isConcurrent()) {
+		baseNodes = graph.getNonNeighbors(node, s);
+	} else {
+		lock_guard<mutex> graphGuard(graphLock);
+		baseNodes = graph.getNonNeighbors(node, s);
+	}
+	baseNodes.insert(node);
+	hashes = make_pair(getIndependentSetHash(baseNodes, FIRST_HASH_SEED),
+			getIndependentSetHash(baseNodes, SECOND_HASH_SEED));
+	{
+		lock_guard<mutex> baseSetsGuard(baseSets.lock);
+		if (!baseSets.hashes.insert(hashes).second) {
+			return PAIR_SKIPPED;
+		}
+	}
+	if (workers[worker]->extensionCache.find(hashes.first, hashes.second) != -1) {
+		return PAIR_IN_CACHE;
+	}
+	extension = workers[worker]->extender->extendToMaxIndependentSet(baseNodes);
+	return PAIR_EXTENDED;
+}
+
+
+/*
+ * The node gets its position and the sets it is paired with under the
+ * exclusive positionsLock, as in newSetFound.
+ */
+template<class T>
+bool ParallelMaximalIndependentSetsEnumerator<T>::generateNode(int worker) {
+	{
+		lock_guard<mutex> stateGuard(lock);
+		if (!hasMoreNodes || isGeneratingNode) {
+			return false;
+		}
+		isGeneratingNode = true;
+	}
+	T node;
+	bool hasNextNode;
+	{
+		lock_guard<mutex> graphGuard(graphLock);
+		node = graph.nextNode();
+		hasNextNode = graph.hasNextNode();
+	}
+	int nodeIndex;
+	unsigned int numberOfSets;
+	{
+		unique_lock<shared_mutex> positionsGuard(positionsLock);
+		nodeIndex = nodesGenerated.size();
+		nodesGenerated.push_back(node);
+		numberOfSets = setHandles.size();
+	}
+	if (numberOfSets > 0) {
+		PairsRange range = {true, nodeIndex, 0, numberOfSets, make_shared<BaseSetsExtended>()};
+		lock_guard<mutex> queueGuard(workers[worker]->queueLock);
+		workers[worker]->queue.push_back(range);
+	}
+	lock_guard<mutex> stateGuard(lock);
+	isGeneratingNode = false;
+	hasMoreNodes = hasNextNode;
+	workVersion++;
+	workAvailable.notify_one();
+	return true;
+}
+
+
+/*
+ * The worker finishes when every worker is waiting for work and there are no
+ * more nodes, since then no pairs are left. While it extends a set or
+ * generates a node it does not hold lock.
+ */
+template<class T>
+void ParallelMaximalIndependentSetsEnumerator<T>::runWorker(int worker) {
+	Worker& self = *workers[worker];
+	while (!isStopping) {
+		long long version = workVersion;
+		int setHandle;
+		T node;
+		shared_ptr<BaseSetsExtended> baseSets;
+		if (takePair(worker, setHandle, node, baseSets)) {
+			set<T> s = setsFound.get(setHandle);
+			pair<uint64_t,uint64_t> hashes;
+			set<T> generatedSet;
+			PairOutcome outcome = extendPair(worker, s, node, *baseSets, hashes, generatedSet);
+			if (outcome == PAIR_SKIPPED) {
+				self.extensionsSkipped++;
+			} else if (outcome == PAIR_IN_CACHE) {
+				self.extensionCacheHits++;
+			} else {
+				if (self.extensionCache.isEnabled()) {
+					self.extensionCacheMisses++;
+				}
+				int handle = newSetFound(worker, generatedSet);
+				self.extensionCache.insert(hashes.first, hashes.second, handle);
+			}
+			continue;
+		}
+		if (generateNode(worker)) {
+			continue;
+		}
+		unique_lock<mutex> stateLock(lock);
+		if (isStopping || isFinished) {
+			return;
+		}
+		if (workVersion != version) {
+			continue;
+		}
+		idleWorkers++;
+		if (idleWorkers == (int)workers.size() && !hasMoreNodes && !isGeneratingNode) {
+			isFinished = true;
+			workAvailable.notify_all();
+			resultAvailable.notify_all();
+			return;
+		}
+		workAvailable.wait(stateLock);
+		idleWorkers--;
+	}
+}
+
+
+/*
+ * Initialization
+ */
+template<class T>
+ParallelMaximalIndependentSetsEnumerator<T>::ParallelMaximalIndependentSetsEnumerator(
+		SuccinctGraphRepresentation<T>& g, IndependentSetExtender<T>& extender,
+		int numberOfThreads, int extensionCacheSize) : graph(g),
+		isGeneratingNode(false), workVersion(0), idleWorkers(0), isStarted(false),
+		isFinished(false), isStopping(false) {
+	vector<IndependentSetExtender<T>*> extenders(1, &extender);
+	for (int t = 1; t < numberOfThreads; t++) {
+		IndependentSetExtender<T>* copy = extender.clone();
+		if (copy == NULL) {
+			break;
+		}
+		extenders.push_back(copy);
+	}
+	int numberOfWorkers = extenders.size();
+	for (int t = 0; t < numberOfWorkers; t++) {
+		workers.push_back(new Worker(extenders[t], extensionCacheSize > 0 ?
+				max(1, extensionCacheSize / numberOfWorkers) : 0));
+	}
+	hasMoreNodes = graph.hasNextNode();
+	newSetFound(0, extender.extendToMaxIndependentSet(set<T>()));
+}
+
+
+template<class T>
+ParallelMaximalIndependentSetsEnumerator<T>::~ParallelMaximalIndependentSetsEnumerator() {
+	{
+		lock_guard<mutex> stateGuard(lock);
+		isStopping = true;
+	}
+	workAvailable.notify_all();
+	resultTaken.notify_all();
+	for (unsigned int t = 0; t < threads.size(); t++) {
+		threads[t].join();
+	}
+	for (unsigned int t = 0; t < workers.size(); t++) {
+		if (t > 0) {
+			delete workers[t]->extender;
+		}
+		delete workers[t];
+	}
+}
+
+
+template<class T>
+bool ParallelMaximalIndependentSetsEnumerator<T>::hasNext() {
+	unique_lock<mutex> stateLock(lock);
+	if (!isStarted) {
+		isStarted = true;
+		for (unsigned int t = 0; t < workers.size(); t++) {
+			threads.push_back(thread(&ParallelMaximalIndependentSetsEnumerator<T>::runWorker, this, t));
+		}
+	}
+	resultAvailable.wait(stateLock, [&] { return !pendingSets.empty() || isFinished; });
+	return !pendingSets.empty();
+}
+
+
+/*
+ * The workers that wait for the results to be returned are woken only when
+ * the queue of results was full.
+ */
+template<class T>
+set<T> ParallelMaximalIndependentSetsEnumerator<T>::next() {
+	if (!hasNext()) {
+		return set<T>();
+	}
+	int handle;
+	{
+		lock_guard<mutex> stateGuard(lock);
+		handle = pendingSets.front();
+		pendingSets.pop_front();
+		if (pendingSets.size() + 1 >= MAX_PENDING_SETS_PER_THREAD * workers.size()) {
+			resultTaken.notify_all();
+		}
+	}
+	return setsFound.get(handle);
+}
+
+
+template<class T>
+unique_lock<mutex> ParallelMaximalIndependentSetsEnumerator<T>::lockGraph() {
+	return unique_lock<mutex>(graphLock);
+}
+
+
+template<class T>
+long long ParallelMaximalIndependentSetsEnumerator<T>::getExtensionCacheHits() {
+	long long hits = 0;
+	for (unsigned int t = 0; t < workers.size(); t++) {
+		hits += workers[t]->extensionCacheHits;
+	}
+	return hits;
+}
+
+
+template<class T>
+long long ParallelMaximalIndependentSetsEnumerator<T>::getExtensionCacheMisses() {
+	long long misses = 0;
+	for (unsigned int t = 0; t < workers.size(); t++) {
+		misses += workers[t]->extensionCacheMisses;
+	}
+	return misses;
+}
+
+
+template<class T>
+long long ParallelMaximalIndependentSetsEnumerator<T>::getExtensionsSkipped() {
+	long long skipped = 0;
+	for (unsigned int t = 0; t < workers.size(); t++) {
+		skipped += workers[t]->extensionsSkipped;
+	}
+	return skipped;
+}
+
+} /* namespace tdenum */
+
+#endif /* PARALLELMAXIMALINDEPENDENTSETSENUMERATOR_H_ */
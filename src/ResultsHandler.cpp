@@ -6,17 +6,60 @@
 #include "TreeDecomposition.h"
 #include <ostream>
 #include <ctime>
+#include <cmath>
 using namespace std;
 
 namespace tdenum {
 
+	ResultInformation::ResultInformation(int index, double time,
+			const TwinReduction& reduction, const ChordalGraph& result) :
+			number(index), time(time), fill(0), width(-1), expBagSize(0) {
+		vector< set<Node> > fillEdges = result.getFillEdges(reduction.getQuotientGraph());
+		for (vector< set<Node> >::iterator it=fillEdges.begin(); it!=fillEdges.end(); ++it) {
+			fill += reduction.getWeight(*(it->begin())) * reduction.getWeight(*(it->rbegin()));
+		}
+		set<NodeSet> maximalCliques = result.getMaximalCliques();
+		for (set<NodeSet>::iterator it=maximalCliques.begin(); it!=maximalCliques.end(); ++it) {
+			int weight = reduction.getWeight(*it);
+			if (width < weight - 1) {
+				width = weight - 1;
+			}
+			expBagSize += pow((double)2,(double)weight);
+		}
+	}
+
 	void ResultInformation::printSummary(ostream& output) {
 		output << "#" << number << " (width " << width << ", fill " << fill
 				<< ", sum of exponents of bag sizes " << expBagSize << "), obtained after " << time << " seconds." << endl;
 	}
 
+	void ResultInformation::save(CheckpointWriter& output) const {
+		output.writeNumber(number);
+		output.writeDouble(time);
+		output.writeNumber(fill);
+		output.writeSignedNumber(width);
+		output.writeNumber(expBagSize);
+	}
+
+	void ResultInformation::load(CheckpointReader& input) {
+		number = input.readNumber();
+		time = input.readDouble();
+		fill = input.readNumber();
+		width = input.readSignedNumber();
+		expBagSize = input.readNumber();
+	}
+
+	set<NodeSet> ResultsHandler::getBags(const ChordalGraph& triangulation) {
+		if (reduction) {
+			return reduction->expand(triangulation.getMaximalCliques());
+		}
+		return triangulation.getMaximalCliques();
+	}
+
 	void ResultsHandler::newResult(const ChordalGraph& triangulation) {
-		ResultInformation currentResult(++resultsFound, getTime(), inputGraph, triangulation);
+		ResultInformation currentResult = reduction ?
+				ResultInformation(++resultsFound, getTime(), *reduction, triangulation) :
+				ResultInformation(++resultsFound, getTime(), inputGraph, triangulation);
 		int width = currentResult.getWidth();
 		int fill = currentResult.getFill();
 		long long bagExpSize = currentResult.getExpBagSize();
@@ -52,7 +95,9 @@ namespace tdenum {
 		currentResult.printSummary(output);
 		if (outputForm == TRIANGULATIONS) {
 			// Print fill edges
-			vector< set<Node> > fillEdges = triangulation.getFillEdges(inputGraph);
+			vector< set<Node> > fillEdges = reduction ?
+					reduction->expandEdges(triangulation.getFillEdges(reduction->getQuotientGraph())) :
+					triangulation.getFillEdges(inputGraph);
 			for (vector< set<Node> >::iterator it=fillEdges.begin(); it!=fillEdges.end(); ++it) {
 				Node u = *(it->begin());
 				Node v = *(++it->begin());
@@ -60,7 +105,7 @@ namespace tdenum {
 			}
 		} else if (outputForm == BAGSETS) {
 			// Print bags
-			set<NodeSet> maximalCliques = triangulation.getMaximalCliques();
+			set<NodeSet> maximalCliques = getBags(triangulation);
 			for (set<NodeSet>::const_iterator it=maximalCliques.begin(); it!=maximalCliques.end(); ++it) {
 				for (NodeSet::const_iterator jt = it->begin(); jt!=it->end(); ++jt) {
 					output << inputNaming[*jt] << " ";
@@ -69,11 +114,11 @@ namespace tdenum {
 			}
 		} else if (outputForm == SINGLETDS) {
 			// Print bags
-			TreeDecomposition td (triangulation.getMaximalCliques());
+			TreeDecomposition td (getBags(triangulation));
 			td.printSingleTree(output, inputNaming);
 		} else if (outputForm == ALLTDS) {
 			// Print bags
-			TreeDecomposition td (triangulation.getMaximalCliques());
+			TreeDecomposition td (getBags(triangulation));
 			td.printAllEdgeOptions(output, inputNaming);
 		}
 		output << endl;
@@ -113,4 +158,33 @@ namespace tdenum {
 		}
 	}
 
+	void ResultsHandler::save(CheckpointWriter& checkpoint) {
+		checkpoint.writeNumber(resultsFound);
+		checkpoint.writeDouble(getTime());
+		minWidthResult.save(checkpoint);
+		minFillResult.save(checkpoint);
+		minBagExpSizeResult.save(checkpoint);
+		checkpoint.writeSignedNumber(minWidth);
+		checkpoint.writeSignedNumber(maxWidth);
+		checkpoint.writeNumber(minFill);
+		checkpoint.writeNumber(maxFill);
+		checkpoint.writeNumber(minBagExpSize);
+		checkpoint.writeNumber(maxBagExpSize);
+	}
+
+	void ResultsHandler::load(CheckpointReader& checkpoint) {
+		resultsFound = checkpoint.readNumber();
+		previousTime = checkpoint.readDouble();
+		startTime = chrono::steady_clock::now();
+		minWidthResult.load(checkpoint);
+		minFillResult.load(checkpoint);
+		minBagExpSizeResult.load(checkpoint);
+		minWidth = checkpoint.readSignedNumber();
+		maxWidth = checkpoint.readSignedNumber();
+		minFill = checkpoint.readNumber();
+		maxFill = checkpoint.readNumber();
+		minBagExpSize = checkpoint.readNumber();
+		maxBagExpSize = checkpoint.readNumber();
+	}
+
 } /* namespace tdenum */
@@ -6,9 +6,11 @@
 #define RESULTSHANDLER_H_
 
 #include <ostream>
-#include <ctime>
+#include <chrono>
 #include <map>
 #include "ChordalGraph.h"
+#include "TwinReduction.h"
+#include "Checkpoint.h"
 using namespace std;
 
 namespace tdenum {
@@ -27,20 +29,30 @@ public:
 		width = result.getTreeWidth();
 		expBagSize = result.getExpBagsSize();
 	}
+	// The result is a triangulation of the quotient graph of the reduction,
+	// and the metrics are of its expansion
+	ResultInformation(int index, double time, const TwinReduction& reduction,
+			const ChordalGraph& result);
 	int getTime() { return time; }
 	int getFill() { return fill; }
 	int getWidth() { return width; }
 	long long getExpBagSize() { return expBagSize; }
 	void printSummary(ostream& output);
+	void save(CheckpointWriter& output) const;
+	void load(CheckpointReader& input);
 };
 
 enum OutputForm { TRIANGULATIONS, BAGSETS, SINGLETDS , ALLTDS};
 
 class ResultsHandler {
 	Graph inputGraph;
+	const TwinReduction* reduction;
 	ostream& output;
 	OutputForm outputForm;
-	clock_t startTime;
+	// The results are timed by the wall clock, which also suits several threads
+	chrono::steady_clock::time_point startTime;
+	// The time of the runs resumed from
+	double previousTime;
 	ResultInformation minWidthResult;
 	ResultInformation minFillResult;
 	ResultInformation minBagExpSizeResult;
@@ -50,17 +62,27 @@ class ResultsHandler {
 	long long minBagExpSize, maxBagExpSize;
 	int resultsFound;
 	double getTime() {
-		return double(clock() - startTime) / CLOCKS_PER_SEC;
+		return previousTime +
+				chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
 	}
+	// Returns the maximal cliques of the result, in the nodes of the input graph
+	set<NodeSet> getBags(const ChordalGraph& triangulation);
 public:
-	ResultsHandler(const Graph& g, ostream& o, OutputForm f, map<int,string> n ) :
-				inputGraph(g), output(o), outputForm(f), inputNaming(n),
+	// If a twin reduction is given, the results are triangulations of its
+	// quotient graph and are expanded to triangulations of g
+	ResultsHandler(const Graph& g, ostream& o, OutputForm f, map<int,string> n,
+			const TwinReduction* r = NULL) :
+				inputGraph(g), reduction(r), output(o), outputForm(f), previousTime(0), inputNaming(n),
 				minWidth(0), maxWidth(0), minFill(0), maxFill(0), minBagExpSize(0),
 				maxBagExpSize(0), resultsFound(0) {
-		startTime = clock();
+		startTime = chrono::steady_clock::now();
 	}
 	void newResult(const ChordalGraph& triangulation);
 	void printReadableSummary(ostream& output);
+	// Writes the results count, the metrics ranges and the time so far
+	void save(CheckpointWriter& checkpoint);
+	// Continues counting and timing from a saved state
+	void load(CheckpointReader& checkpoint);
 };
 
 
@@ -0,0 +1,236 @@
+#include "SaturatedGraph.h"
+#include "DenseGraph.h"
+#include "DataStructures.h"
+#include <algorithm>
+#include <iostream>
+
+namespace tdenum {
+
+SaturatedGraph::SaturatedGraph(const Graph& base, const DenseGraph* denseBase) :
+		base(&base), denseBase(denseBase),
+		fillNeighbors(base.getNumberOfNodes()), numberOfFillEdges(0) {}
+
+/*
+ * Edges of the base graph are not stored again.
+ */
+void SaturatedGraph::addEdge(Node u, Node v) {
+	if (!isValidNode(u) || !isValidNode(v) || u == v || areNeighbors(u, v)) {
+		return;
+	}
+	NodeSet& uFill = fillNeighbors[u];
+	uFill.insert(lower_bound(uFill.begin(), uFill.end(), v), v);
+	NodeSet& vFill = fillNeighbors[v];
+	vFill.insert(lower_bound(vFill.begin(), vFill.end(), u), u);
+	numberOfFillEdges++;
+}
+
+void SaturatedGraph::addClique(const set<Node>& newClique) {
+	for (set<Node>::const_iterator i = newClique.begin(); i != newClique.end(); ++i) {
+		for (set<Node>::const_iterator j = newClique.begin(); j != i; ++j) {
+			addEdge(*j, *i);
+		}
+	}
+}
+
+void SaturatedGraph::addClique(const vector<Node>& newClique) {
+	for (vector<Node>::const_iterator i = newClique.begin(); i != newClique.end(); ++i) {
+		for (vector<Node>::const_iterator j = newClique.begin(); j != i; ++j) {
+			addEdge(*j, *i);
+		}
+	}
+}
+
+void SaturatedGraph::addClique(NodeRange newClique) {
+	for (const Node* i = newClique.begin(); i != newClique.end(); ++i) {
+		for (const Node* j = newClique.begin(); j != i; ++j) {
+			addEdge(*j, *i);
+		}
+	}
+}
+
+void SaturatedGraph::saturateNodeSets(const set< set<Node> >& s) {
+	for (set< set<Node> >::const_iterator i = s.begin(); i != s.end(); ++i) {
+		addClique(*i);
+	}
+}
+
+void SaturatedGraph::saturateNodeSets(const set< vector<Node> >& s) {
+	for (set< vector<Node> >::const_iterator i = s.begin(); i != s.end(); ++i) {
+		addClique(*i);
+	}
+}
+
+Graph SaturatedGraph::toGraph() const {
+	Graph g(*base);
+	for (Node v=0; v<getNumberOfNodes(); v++) {
+		for (Node u : fillNeighbors[v]) {
+			if (v < u) {
+				g.addEdge(v, u);
+			}
+		}
+	}
+	return g;
+}
+
+const Graph& SaturatedGraph::getBase() const {
+	return *base;
+}
+
+const DenseGraph* SaturatedGraph::getDenseBase() const {
+	return denseBase;
+}
+
+const NodeSet& SaturatedGraph::getFillNeighbors(Node v) const {
+	return fillNeighbors[v];
+}
+
+int SaturatedGraph::getNumberOfFillEdges() const {
+	return numberOfFillEdges;
+}
+
+vector< set<Node> > SaturatedGraph::getFillEdges() const {
+	vector< set<Node> > edges;
+	for (Node v=0; v<getNumberOfNodes(); v++) {
+		for (Node u : fillNeighbors[v]) {
+			if (v < u) {
+				set<Node> edge;
+				edge.insert(v);
+				edge.insert(u);
+				edges.push_back(edge);
+			}
+		}
+	}
+	return edges;
+}
+
+bool SaturatedGraph::isValidNode(Node v) const {
+	if (v<0 || v>=getNumberOfNodes()) {
+		cout << "Invalid input" << endl;
+		return false;
+	}
+	return true;
+}
+
+set<Node> SaturatedGraph::getNodes() const {
+	return base->getNodes();
+}
+
+int SaturatedGraph::getNumberOfEdges() const {
+	return base->getNumberOfEdges() + numberOfFillEdges;
+}
+
+int SaturatedGraph::getNumberOfNodes() const {
+	return fillNeighbors.size();
+}
+
+SaturatedGraph::Neighbors SaturatedGraph::getNeighbors(Node v) const {
+	return Neighbors(base->getNeighbors(v), fillNeighbors[v]);
+}
+
+vector<bool> SaturatedGraph::getNeighborsMap(Node v) const {
+	vector<bool> result = base->getNeighborsMap(v);
+	for (Node u : fillNeighbors[v]) {
+		result[u] = true;
+	}
+	return result;
+}
+
+NodeSet SaturatedGraph::getNeighbors(const set<Node>& inputSet) const {
+	return getNeighbors(NodeSet(inputSet.begin(), inputSet.end()));
+}
+
+/*
+ * Returns the set of neighbors of nodes in the given node set without returning
+ * nodes that are in the input node set
+ */
+NodeSet SaturatedGraph::getNeighbors(const vector<Node>& inputSet) const {
+	NodeSet neighbors;
+	for (Node v : inputSet) {
+		if (!isValidNode(v)) {
+			return neighbors;
+		}
+	}
+	TraversalWorkspace& workspace = TraversalWorkspace::get(getNumberOfNodes());
+	for (Node v : inputSet) {
+		workspace.mark(v);
+	}
+	for (Node v : inputSet) {
+		for (Node u : getNeighbors(v)) {
+			if (workspace.markIfNew(u)) {
+				neighbors.push_back(u);
+			}
+		}
+	}
+	sort(neighbors.begin(), neighbors.end());
+	return neighbors;
+}
+
+bool SaturatedGraph::areNeighbors(Node u, Node v) const {
+	bool isBaseEdge = denseBase ? denseBase->areNeighbors(u, v) : base->areNeighbors(u, v);
+	return isBaseEdge ||
+			binary_search(fillNeighbors[u].begin(), fillNeighbors[u].end(), v);
+}
+
+vector<NodeSet> SaturatedGraph::getComponents(const set<Node>& removedNodes) const {
+	return getComponents(NodeSet(removedNodes.begin(), removedNodes.end()));
+}
+
+vector<NodeSet> SaturatedGraph::getComponents(const NodeSet& removedNodes) const {
+	vector<NodeSet> components;
+	for (Node v : removedNodes) {
+		if (!isValidNode(v)) {
+			return components;
+		}
+	}
+	TraversalWorkspace& workspace = TraversalWorkspace::get(getNumberOfNodes());
+	for (Node v : removedNodes) {
+		workspace.mark(v);
+	}
+	collectComponents(workspace, getNumberOfNodes() - removedNodes.size(), components);
+	return components;
+}
+
+void SaturatedGraph::collectComponents(TraversalWorkspace& workspace,
+		int numberOfUnhandeledNodes, vector<NodeSet>& components) const {
+	for (Node start = 0; start < getNumberOfNodes() && numberOfUnhandeledNodes > 0; start++) {
+		if (!workspace.markIfNew(start)) {
+			continue;
+		}
+		components.push_back(NodeSet());
+		NodeSet& component = components.back();
+		component.push_back(start);
+		// BFS through the component
+		for (unsigned int head = 0; head < component.size(); head++) {
+			for (Node u : getNeighbors(component[head])) {
+				if (workspace.markIfNew(u)) {
+					component.push_back(u);
+				}
+			}
+		}
+		numberOfUnhandeledNodes -= component.size();
+		sort(component.begin(), component.end());
+	}
+}
+
+vector<int> SaturatedGraph::getComponentsMap(const vector<Node>& removedNodes) const {
+	vector<int> componentsMap(getNumberOfNodes(), -1);
+	vector<NodeSet> components = getComponents(removedNodes);
+	for (unsigned int i = 0; i < components.size(); i++) {
+		for (Node v : components[i]) {
+			componentsMap[v] = i+1;
+		}
+	}
+	return componentsMap;
+}
+
+void SaturatedGraph::print() const {
+	for (Node v=0; v<getNumberOfNodes(); v++) {
+		cout << v << " has neighbors: {";
+		for (Node u : getNeighbors(v)) {
+			cout << u << " ";
+		}
+		cout << "}" << endl;
+	}
+}
+
+} /* namespace tdenum */
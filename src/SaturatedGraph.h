@@ -0,0 +1,144 @@
+#ifndef SATURATEDGRAPH_H_
+#define SATURATEDGRAPH_H_
+
+#include "Graph.h"
+#include <iterator>
+
+namespace tdenum {
+
+class DenseGraph;
+
+/**
+ * A graph obtained from a base graph by adding edges, where only the added
+ * (fill) edges are stored and the base graph is referenced.
+ * Copying it copies the fill edges only, so it replaces copies of the whole
+ * input graph when saturating separators and triangulating.
+ * The base graph must outlive this object and must not change.
+ * Provides the read API of Graph.
+ */
+class SaturatedGraph {
+	const Graph* base;
+	// A dense copy of the base graph for the neighbor tests, or NULL
+	const DenseGraph* denseBase;
+	// The sorted fill neighbors of every node
+	vector<NodeSet> fillNeighbors;
+	int numberOfFillEdges;
+
+	bool isValidNode(Node v) const;
+	// Returns in components the components of the nodes not marked in the
+	// workspace, given how many such nodes there are
+	void collectComponents(TraversalWorkspace& workspace, int numberOfUnhandeledNodes,
+			vector<NodeSet>& components) const;
+
+public:
+	/*
+	 * Iterates over the neighbors of a node in ascending order, by merging
+	 * its base neighbors and its fill neighbors.
+	 */
+	class NeighborIterator {
+		set<Node>::const_iterator baseIt, baseEnd;
+		NodeSet::const_iterator fillIt, fillEnd;
+		bool isBaseNext() const {
+			return fillIt == fillEnd || (baseIt != baseEnd && *baseIt < *fillIt);
+		}
+	public:
+		typedef forward_iterator_tag iterator_category;
+		typedef Node value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const Node* pointer;
+		typedef Node reference;
+		NeighborIterator(set<Node>::const_iterator baseIt, set<Node>::const_iterator baseEnd,
+				NodeSet::const_iterator fillIt, NodeSet::const_iterator fillEnd) :
+			baseIt(baseIt), baseEnd(baseEnd), fillIt(fillIt), fillEnd(fillEnd) {}
+		Node operator*() const { return isBaseNext() ? *baseIt : *fillIt; }
+		NeighborIterator& operator++() {
+			if (isBaseNext()) {
+				++baseIt;
+			} else {
+				++fillIt;
+			}
+			return *this;
+		}
+		bool operator==(const NeighborIterator& other) const {
+			return baseIt == other.baseIt && fillIt == other.fillIt;
+		}
+		bool operator!=(const NeighborIterator& other) const { return !(*this == other); }
+	};
+
+	class Neighbors {
+		const set<Node>& baseNeighbors;
+		const NodeSet& fillNeighbors;
+	public:
+		Neighbors(const set<Node>& b, const NodeSet& f) : baseNeighbors(b), fillNeighbors(f) {}
+		NeighborIterator begin() const {
+			return NeighborIterator(baseNeighbors.begin(), baseNeighbors.end(),
+					fillNeighbors.begin(), fillNeighbors.end());
+		}
+		NeighborIterator end() const {
+			return NeighborIterator(baseNeighbors.end(), baseNeighbors.end(),
+					fillNeighbors.end(), fillNeighbors.end());
+		}
+		int size() const { return baseNeighbors.size() + fillNeighbors.size(); }
+	};
+
+	// Constructs the base graph with no fill edges. The edges of the base
+	// graph are tested in denseBase if given, which must be a copy of it that
+	// outlives this object.
+	SaturatedGraph(const Graph& base, const DenseGraph* denseBase = NULL);
+	// Connects the given two nodes by a edge
+	void addEdge(Node u, Node v);
+	// Adds edges that will make that given node set a clique
+	void addClique(const set<Node>& s);
+	// Adds edges that will make that given node set a clique
+	void addClique(const vector<Node>& s);
+	// Adds edges that will make that given node set a clique
+	void addClique(NodeRange s);
+	// Adds edges that will make the given node sets cliques
+	void saturateNodeSets(const set< set<Node> >& s);
+	// Adds edges that will make the given node sets cliques
+	void saturateNodeSets(const set< vector<Node> >& s);
+	// Returns a full copy of this graph
+	Graph toGraph() const;
+
+	// Returns the graph the fill edges were added to
+	const Graph& getBase() const;
+	// Returns the dense copy of the base graph, or NULL if there is none
+	const DenseGraph* getDenseBase() const;
+	// Returns the sorted neighbors of the given node that are not in the base graph
+	const NodeSet& getFillNeighbors(Node v) const;
+	// Returns the number of edges added to the base graph
+	int getNumberOfFillEdges() const;
+	// Returns the edges added to the base graph
+	vector< set<Node> > getFillEdges() const;
+
+	// Returns the nodes of the graph
+	set<Node> getNodes() const;
+	// Returns the number of edges in the graph
+	int getNumberOfEdges() const;
+	// Returns the number of nodes in the graph
+	int getNumberOfNodes() const;
+	// Returns the neighbors of the given node
+	Neighbors getNeighbors(Node v) const;
+	// Returns a vector the size of the number of nodes in the graph, stating
+	// whether the index nodes are neighbors of the input node.
+	vector<bool> getNeighborsMap(Node v) const;
+	// Returns the neighbors of the given node set
+	NodeSet getNeighbors(const vector<Node>& s) const;
+	// Returns the neighbors of the given node set
+	NodeSet getNeighbors(const set<Node>& s) const;
+	// Returns whether there is an edge between the given two nodes
+	bool areNeighbors(Node u, Node v) const;
+	// Returns a map from the Nodes numbers to the number of the component they are in.
+	// -1 if they are in the input set.
+	vector<int> getComponentsMap(const vector<Node>& removedNodes) const;
+	// Returns the set of components obtained by removing the given node set
+	vector<NodeSet> getComponents(const set<Node>& removedNodes) const;
+	// Returns the set of components obtained by removing the given node set
+	vector<NodeSet> getComponents(const NodeSet& removedNodes) const;
+	// Prints the graph
+	void print() const;
+};
+
+} /* namespace tdenum */
+
+#endif /* SATURATEDGRAPH_H_ */
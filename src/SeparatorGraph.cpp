@@ -3,41 +3,177 @@
 
 namespace tdenum {
 
-SeparatorGraph::SeparatorGraph(const Graph& g, SeparatorsScoringCriterion c) :
-		graph(g), nodesEnumerator(g, c), nodesGenerated(0) {}
+SeparatorGraph::SeparatorGraph(const Graph& g, SeparatorPool& pool,
+		SeparatorsScoringCriterion c, int separatorThreads, int maxSeparatorSize,
+		size_t cacheBytes) :
+		graph(g), denseGraph(NULL), pool(pool),
+		nodesEnumerator(g, c, separatorThreads, maxSeparatorSize),
+		nodesGenerated(0), componentMaps(cacheBytes) {
+	if (DenseGraph::isSearchFaster(graph.getNumberOfNodes(), graph.getNumberOfEdges())) {
+		denseGraph = new DenseGraph(graph);
+	}
+}
+
+SeparatorGraph::~SeparatorGraph() {
+	delete denseGraph;
+}
 
 bool SeparatorGraph::hasNextNode() {
 	return nodesEnumerator.hasNext();
 }
 
-MinimalSeparator SeparatorGraph::nextNode() {
+SeparatorId SeparatorGraph::nextNode() {
 	nodesGenerated++;
-	return nodesEnumerator.next();
+	return pool.intern(nodesEnumerator.next());
 }
 
-// check if the nodes of v are in different components of the graph obtained by removing u
-bool SeparatorGraph::hasEdge(const MinimalSeparator& s, const MinimalSeparator& t) {
-	vector<int> componentsMap = graph.getComponentsMap(s);
-	int componentContainingT = 0;
-	for (MinimalSeparator::const_iterator it = t.begin(); it != t.end(); ++it) {
-		int componentContainingCurrentNode = componentsMap[*it];
-		if (componentContainingT == componentContainingCurrentNode) {
-			continue;
-		} else if (componentContainingCurrentNode == -1) {
-			continue;
-		} else if (componentContainingT == 0) {
-			componentContainingT = componentContainingCurrentNode;
+/*
+ * Checks whether the nodes are in different components according to the map,
+ * ignoring the nodes with the given label of the removed nodes.
+ */
+template<class Label>
+static bool isSeparatedBy(const vector<Label>& componentsMap, NodeRange nodes,
+		Label removedLabel) {
+	bool isComponentFound = false;
+	Label componentContainingNodes = 0;
+	for (Node v : nodes) {
+		Label componentContainingCurrentNode = componentsMap[v];
+		if (componentContainingCurrentNode == removedLabel) {
 			continue;
-		} else {
+		} else if (!isComponentFound) {
+			componentContainingNodes = componentContainingCurrentNode;
+			isComponentFound = true;
+		} else if (componentContainingNodes != componentContainingCurrentNode) {
 			return true;
 		}
 	}
 	return false;
 }
 
+bool SeparatorGraph::hasEdge(const SeparatorId& s, const SeparatorId& t) {
+	set<SeparatorId> separators;
+	separators.insert(t);
+	return getNonNeighbors(s, separators).empty();
+}
+
+/*
+ * The stored pairs are looked up under a shared lock, and the other pairs are
+ * tested without holding the lock of the rows, so several threads can test
+ * pairs at once. A components map that is not cached is computed into a
+ * buffer of the calling thread.
+ */
+set<SeparatorId> SeparatorGraph::getNonNeighbors(const SeparatorId& s,
+		const set<SeparatorId>& separators) {
+	set<SeparatorId> nonNeighbors;
+	vector<SeparatorId> untested;
+	{
+		shared_lock<shared_mutex> rowsGuard(rowsLock);
+		for (SeparatorId t : separators) {
+			bool crossing;
+			if (!findCrossing(s, t, crossing)) {
+				untested.push_back(t);
+			} else if (!crossing) {
+				nonNeighbors.insert(nonNeighbors.end(), t);
+			}
+		}
+	}
+	if (untested.empty()) {
+		return nonNeighbors;
+	}
+	vector<bool> crossings(untested.size());
+	bool isMapCached = false;
+	{
+		lock_guard<mutex> cacheGuard(cacheLock);
+		const vector<uint16_t>* labels = componentMaps.find(s);
+		if (labels) {
+			for (unsigned int i = 0; i < untested.size(); i++) {
+				crossings[i] = isSeparatedBy(*labels, pool.get(untested[i]), (uint16_t)0);
+			}
+			isMapCached = true;
+		}
+	}
+	if (!isMapCached) {
+		static thread_local vector<int> componentsMap;
+		if (denseGraph) {
+			denseGraph->getComponentsMap(pool.get(s), componentsMap);
+		} else {
+			graph.getComponentsMap(pool.get(s), componentsMap);
+		}
+		for (unsigned int i = 0; i < untested.size(); i++) {
+			crossings[i] = isSeparatedBy(componentsMap, pool.get(untested[i]), -1);
+		}
+		lock_guard<mutex> cacheGuard(cacheLock);
+		componentMaps.insert(s, componentsMap);
+	}
+	{
+		unique_lock<shared_mutex> rowsGuard(rowsLock);
+		for (unsigned int i = 0; i < untested.size(); i++) {
+			// Minimal separators cross each other symmetrically
+			storeCrossing(s, untested[i], crossings[i]);
+			storeCrossing(untested[i], s, crossings[i]);
+		}
+	}
+	for (unsigned int i = 0; i < untested.size(); i++) {
+		if (!crossings[i]) {
+			nonNeighbors.insert(untested[i]);
+		}
+	}
+	return nonNeighbors;
+}
+
+bool SeparatorGraph::findCrossing(SeparatorId s, SeparatorId t, bool& crossing) const {
+	if (s < testedRows.size() && (int)t < testedRows[s].getCapacity() &&
+			testedRows[s].contains(t)) {
+		crossing = crossingRows[s].contains(t);
+		return true;
+	}
+	return false;
+}
+
+/*
+ * The rows grow to the number of separators in the pool, and at least double
+ * their capacity, so they are only resized a logarithmic number of times.
+ */
+void SeparatorGraph::storeCrossing(SeparatorId s, SeparatorId t, bool crossing) {
+	if (s >= testedRows.size()) {
+		testedRows.resize(pool.size());
+		crossingRows.resize(pool.size());
+	}
+	int capacity = testedRows[s].getCapacity();
+	if ((int)t >= capacity) {
+		capacity = max(pool.size(), 2*capacity);
+		testedRows[s].resize(capacity);
+		crossingRows[s].resize(capacity);
+	}
+	testedRows[s].insert(t);
+	if (crossing) {
+		crossingRows[s].insert(t);
+	}
+}
+
 int SeparatorGraph::getNumberOfNodesGenerated() {
 	return nodesGenerated;
 }
 
+void SeparatorGraph::save(CheckpointWriter& output) const {
+	output.writeNumber(nodesGenerated);
+	nodesEnumerator.save(output);
+}
+
+void SeparatorGraph::load(CheckpointReader& input) {
+	nodesGenerated = input.readNumber();
+	nodesEnumerator.load(input);
+}
+
+long long SeparatorGraph::getNumberOfCacheHits() const {
+	lock_guard<mutex> cacheGuard(cacheLock);
+	return componentMaps.getNumberOfHits();
+}
+
+long long SeparatorGraph::getNumberOfCacheMisses() const {
+	lock_guard<mutex> cacheGuard(cacheLock);
+	return componentMaps.getNumberOfMisses();
+}
+
 } /* namespace tdenum */
 
@@ -1,7 +1,13 @@
 #ifndef SEPARATORGRAPH_H_
 #define SEPARATORGRAPH_H_
 #include "MinimalSeparatorsEnumerator.h"
+#include "DenseGraph.h"
+#include "SeparatorPool.h"
+#include "NodeBitset.h"
+#include "ComponentMapCache.h"
 #include "SuccinctGraphRepresentation.h"
+#include <mutex>
+#include <shared_mutex>
 
 namespace tdenum {
 
@@ -9,22 +15,69 @@ namespace tdenum {
  * A polynomial succinct graph representation of a separator graph;
  * A node for every minimal separator of the provided graph,
  * An edge appears between two minimal separators if they are crossing.
+ * The nodes are the ids of the minimal separators in the given pool.
+ * Optionally, only the minimal separators up to a given size are nodes.
  */
-class SeparatorGraph : public SuccinctGraphRepresentation<MinimalSeparator> {
-	Graph graph;
+class SeparatorGraph : public SuccinctGraphRepresentation<SeparatorId> {
+	CompactGraph graph;
+	// A dense copy of the graph for the components maps, or NULL if they are
+	// found faster in graph
+	DenseGraph* denseGraph;
+	SeparatorPool& pool;
 	MinimalSeparatorsEnumerator nodesEnumerator;
 	int nodesGenerated;
+	// The components maps of the separators tested recently, guarded by cacheLock
+	ComponentMapCache componentMaps;
+	mutable mutex cacheLock;
+	// The crossing relation of the pairs that were already tested, as bitset
+	// rows indexed by the separator ids. Bit t of testedRows[s] states whether
+	// s and t were tested, and then bit t of crossingRows[s] whether they cross.
+	// Looking up the rows is shared, and storing in them is exclusive.
+	vector<NodeBitset> testedRows;
+	vector<NodeBitset> crossingRows;
+	mutable shared_mutex rowsLock;
+	// Returns whether the crossing relation of s and t is stored, and if so
+	// sets crossing to it. Called under rowsLock.
+	bool findCrossing(SeparatorId s, SeparatorId t, bool& crossing) const;
+	// Stores the crossing relation of s and t in the row of s. Called under
+	// an exclusive rowsLock.
+	void storeCrossing(SeparatorId s, SeparatorId t, bool crossing);
+	// Disable copying
+	SeparatorGraph(const SeparatorGraph&);
+	SeparatorGraph& operator=(const SeparatorGraph&);
 public:
-	// Initialization
-	SeparatorGraph(const Graph& g, SeparatorsScoringCriterion c);
+	// Initialization, the separators are generated with the given number of
+	// threads. Only separators with at most maxSeparatorSize nodes are nodes,
+	// or all of them if it is negative. The components maps of the separators
+	// are cached within the given number of bytes.
+	SeparatorGraph(const Graph& g, SeparatorPool& pool, SeparatorsScoringCriterion c,
+			int separatorThreads = 1, int maxSeparatorSize = -1,
+			size_t cacheBytes = DEFAULT_COMPONENT_MAP_CACHE_BYTES);
+	virtual ~SeparatorGraph();
 	// Checks whether there is another minimal separator
 	virtual bool hasNextNode();
-	// Returns another minimal separator
-	virtual MinimalSeparator nextNode();
-	// Checks whether the minimal separators are crossing
-	virtual bool hasEdge(const MinimalSeparator& u, const MinimalSeparator& v);
+	// Returns the id of another minimal separator
+	virtual SeparatorId nextNode();
+	// Checks whether the minimal separators are crossing. Every pair is tested
+	// once, and the answer is remembered for both orders.
+	virtual bool hasEdge(const SeparatorId& u, const SeparatorId& v);
+	// Returns the separators in the set that do not cross s. The components
+	// map of s is looked up or computed once for all the untested pairs.
+	virtual set<SeparatorId> getNonNeighbors(const SeparatorId& s,
+			const set<SeparatorId>& separators);
+	// The crossing tests only read the graph and the pool, and the tested
+	// pairs and the cache are guarded by their own locks
+	virtual bool isConcurrent() const { return true; }
 	// Returns how many nodes were already generated
 	int getNumberOfNodesGenerated();
+	// Returns the numbers of hits and misses of the components maps cache
+	long long getNumberOfCacheHits() const;
+	long long getNumberOfCacheMisses() const;
+	// Writes the state of the separators enumeration. The crossing relations
+	// and the components maps are not saved, and are found again when needed.
+	void save(CheckpointWriter& output) const;
+	// Continues the separators enumeration from a saved state
+	void load(CheckpointReader& input);
 };
 
 } /* namespace tdenum */
@@ -0,0 +1,147 @@
+#include "SeparatorPool.h"
+#include "DataStructures.h"
+#include <algorithm>
+
+namespace tdenum {
+
+const SeparatorId SeparatorPool::EMPTY_SLOT;
+
+SeparatorPool::SeparatorPool() {}
+
+uint64_t SeparatorPool::getFingerprint(NodeRange separator) const {
+	return NodeSetHash()(separator);
+}
+
+size_t SeparatorPool::findSlot(NodeRange separator, uint64_t fingerprint) const {
+	size_t mask = slots.size() - 1;
+	size_t slot = fingerprint & mask;
+	for (; slots[slot] != EMPTY_SLOT; slot = (slot+1) & mask) {
+		SeparatorId id = slots[slot];
+		if (fingerprints[id] != fingerprint) {
+			continue;
+		}
+		NodeRange candidate = separators[id];
+		if (candidate.size() == separator.size() &&
+				equal(separator.begin(), separator.end(), candidate.begin())) {
+			break;
+		}
+	}
+	return slot;
+}
+
+/*
+ * Most separators are already in the pool, so they are first looked up under
+ * the shared lock. Keeps at most half of the slots used.
+ */
+SeparatorId SeparatorPool::intern(const MinimalSeparator& separator) {
+	NodeRange range(separator.data(), separator.data() + separator.size());
+	uint64_t fingerprint = getFingerprint(range);
+	{
+		shared_lock<shared_mutex> readLock(lock);
+		if (!slots.empty()) {
+			size_t slot = findSlot(range, fingerprint);
+			if (slots[slot] != EMPTY_SLOT) {
+				return slots[slot];
+			}
+		}
+	}
+	unique_lock<shared_mutex> writeLock(lock);
+	if (2*(fingerprints.size()+1) > slots.size()) {
+		rehash(slots.empty() ? 64 : 2*slots.size());
+	}
+	size_t slot = findSlot(range, fingerprint);
+	if (slots[slot] != EMPTY_SLOT) {
+		return slots[slot];
+	}
+	// Start a new chunk if the separator does not fit in the last one
+	if (chunks.empty() || chunks.back().size() + separator.size() > chunks.back().capacity()) {
+		chunks.push_back(vector<Node>());
+		chunks.back().reserve(max((size_t)CHUNK_SIZE, separator.size()));
+	}
+	vector<Node>& chunk = chunks.back();
+	size_t start = chunk.size();
+	chunk.insert(chunk.end(), separator.begin(), separator.end());
+	SeparatorId id = fingerprints.size();
+	separators.push_back(NodeRange(chunk.data() + start, chunk.data() + chunk.size()));
+	fingerprints.push_back(fingerprint);
+	slots[slot] = id;
+	return id;
+}
+
+set<SeparatorId> SeparatorPool::intern(const set<MinimalSeparator>& separators) {
+	set<SeparatorId> ids;
+	for (const MinimalSeparator& separator : separators) {
+		ids.insert(intern(separator));
+	}
+	return ids;
+}
+
+bool SeparatorPool::find(const MinimalSeparator& separator, SeparatorId& id) const {
+	shared_lock<shared_mutex> readLock(lock);
+	if (slots.empty()) {
+		return false;
+	}
+	NodeRange range(separator.data(), separator.data() + separator.size());
+	size_t slot = findSlot(range, getFingerprint(range));
+	if (slots[slot] == EMPTY_SLOT) {
+		return false;
+	}
+	id = slots[slot];
+	return true;
+}
+
+void SeparatorPool::rehash(size_t numberOfSlots) {
+	slots.assign(numberOfSlots, EMPTY_SLOT);
+	size_t mask = numberOfSlots - 1;
+	for (SeparatorId id = 0; id < fingerprints.size(); id++) {
+		size_t slot = fingerprints[id] & mask;
+		while (slots[slot] != EMPTY_SLOT) {
+			slot = (slot+1) & mask;
+		}
+		slots[slot] = id;
+	}
+}
+
+NodeRange SeparatorPool::get(SeparatorId id) const {
+	shared_lock<shared_mutex> readLock(lock);
+	return separators[id];
+}
+
+MinimalSeparator SeparatorPool::getSeparator(SeparatorId id) const {
+	NodeRange range = get(id);
+	return MinimalSeparator(range.begin(), range.end());
+}
+
+set<MinimalSeparator> SeparatorPool::getSeparators(const set<SeparatorId>& ids) const {
+	set<MinimalSeparator> separators;
+	for (SeparatorId id : ids) {
+		separators.insert(getSeparator(id));
+	}
+	return separators;
+}
+
+int SeparatorPool::size() const {
+	shared_lock<shared_mutex> readLock(lock);
+	return fingerprints.size();
+}
+
+void SeparatorPool::save(CheckpointWriter& output) const {
+	shared_lock<shared_mutex> readLock(lock);
+	output.writeNumber(separators.size());
+	for (NodeRange separator : separators) {
+		output.writeSortedNumbers(separator.begin(), separator.end(), separator.size());
+	}
+}
+
+void SeparatorPool::load(CheckpointReader& input) {
+	uint64_t size = input.readNumber();
+	for (uint64_t id = 0; id < size && input.isValid(); id++) {
+		MinimalSeparator separator;
+		input.readSortedNumbers<Node>(separator);
+		if (intern(separator) != id) {
+			input.fail();
+		}
+	}
+}
+
+} /* namespace tdenum */
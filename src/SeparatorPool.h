@@ -0,0 +1,69 @@
+#ifndef SEPARATORPOOL_H_
+#define SEPARATORPOOL_H_
+
+#include "Graph.h"
+#include "Checkpoint.h"
+#include <set>
+#include <mutex>
+#include <shared_mutex>
+#include <stdint.h>
+
+namespace tdenum {
+
+typedef uint32_t SeparatorId;
+
+/**
+ * Stores every minimal separator once and identifies it by a dense id,
+ * assigned in the order the separators are added.
+ * The nodes of the separators are kept one after the other in large chunks,
+ * and an open addressing hash table with linear probing finds the id of a
+ * separator. Separators are never removed.
+ * The pool can be used by several threads at once. The chunks are never moved,
+ * so the ranges it returns stay valid.
+ */
+class SeparatorPool {
+	vector< vector<Node> > chunks;
+	// The nodes of the separators by id, in the chunks
+	vector<NodeRange> separators;
+	vector<uint64_t> fingerprints;
+	// Every slot holds an id, or EMPTY_SLOT
+	vector<SeparatorId> slots;
+	static const SeparatorId EMPTY_SLOT = (SeparatorId)-1;
+	static const int CHUNK_SIZE = 1 << 16;
+	// Readers of the pool share it, and adding a separator is exclusive
+	mutable shared_mutex lock;
+	uint64_t getFingerprint(NodeRange separator) const;
+	// Returns the slot holding the id of the separator, or the empty slot
+	// where it would be added
+	size_t findSlot(NodeRange separator, uint64_t fingerprint) const;
+	// Rebuilds the table with the given number of slots, a power of 2
+	void rehash(size_t numberOfSlots);
+
+	SeparatorPool(const SeparatorPool&);
+	SeparatorPool& operator=(const SeparatorPool&);
+public:
+	SeparatorPool();
+	// Returns the id of the given separator, adding it if it is new
+	SeparatorId intern(const MinimalSeparator& separator);
+	// Returns the ids of the given separators, adding the new ones
+	set<SeparatorId> intern(const set<MinimalSeparator>& separators);
+	// Returns whether the separator was added, and if so sets id to its id
+	bool find(const MinimalSeparator& separator, SeparatorId& id) const;
+	// Returns the nodes of the separator with the given id
+	NodeRange get(SeparatorId id) const;
+	// Returns a copy of the separator with the given id
+	MinimalSeparator getSeparator(SeparatorId id) const;
+	// Returns copies of the separators with the given ids
+	set<MinimalSeparator> getSeparators(const set<SeparatorId>& ids) const;
+	// Returns the number of separators in the pool
+	int size() const;
+	// Writes the separators in the order of their ids
+	void save(CheckpointWriter& output) const;
+	// Adds the saved separators, so they get the same ids as when saved.
+	// The separators already in the pool must be the first of them.
+	void load(CheckpointReader& input);
+};
+
+} /* namespace tdenum */
+
+#endif /* SEPARATORPOOL_H_ */
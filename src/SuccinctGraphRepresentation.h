@@ -1,6 +1,9 @@
 #ifndef SUCCINCTGRAPHREPRESENTATION_H_
 #define SUCCINCTGRAPHREPRESENTATION_H_
 
+#include <set>
+using namespace std;
+
 namespace tdenum {
 
 /**
@@ -18,6 +21,21 @@ public:
 	virtual T nextNode() = 0;
 	// Checks whether an edge exists
 	virtual bool hasEdge(const T& u, const T& v) = 0;
+	// Returns the nodes of the given set that do not share an edge with u.
+	// Representations may override it to answer faster than a call to
+	// hasEdge for every node.
+	virtual set<T> getNonNeighbors(const T& u, const set<T>& nodes) {
+		set<T> nonNeighbors;
+		for (typename set<T>::const_iterator i = nodes.begin(); i != nodes.end(); ++i) {
+			if (!hasEdge(u, *i)) {
+				nonNeighbors.insert(nonNeighbors.end(), *i);
+			}
+		}
+		return nonNeighbors;
+	}
+	// Returns whether hasEdge and getNonNeighbors may be called by several
+	// threads at once, and while another thread calls nextNode
+	virtual bool isConcurrent() const { return false; }
 };
 
 } /* namespace tdenum */
@@ -0,0 +1,78 @@
+#include "ThreadPool.h"
+
+namespace tdenum {
+
+ThreadPool::ThreadPool(int numberOfThreads) : work(NULL), numberOfTasks(0),
+		nextTask(0), batchNumber(0), busyWorkers(0), isStopping(false) {
+	for (int t = 1; t < numberOfThreads; t++) {
+		workers.push_back(thread(&ThreadPool::runWorker, this, t));
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		lock_guard<mutex> guard(lock);
+		isStopping = true;
+	}
+	batchStarted.notify_all();
+	for (unsigned int t = 0; t < workers.size(); t++) {
+		workers[t].join();
+	}
+}
+
+int ThreadPool::getNumberOfThreads() const {
+	return workers.size() + 1;
+}
+
+void ThreadPool::runTasks(int thread) {
+	for (int task = nextTask++; task < numberOfTasks; task = nextTask++) {
+		(*work)(thread, task);
+	}
+}
+
+/*
+ * Waits for every new batch, and takes its tasks along with the other threads.
+ */
+void ThreadPool::runWorker(int thread) {
+	long long lastBatch = 0;
+	unique_lock<mutex> guard(lock);
+	while (true) {
+		batchStarted.wait(guard, [&] { return isStopping || batchNumber != lastBatch; });
+		if (isStopping) {
+			return;
+		}
+		lastBatch = batchNumber;
+		guard.unlock();
+		runTasks(thread);
+		guard.lock();
+		if (--busyWorkers == 0) {
+			batchFinished.notify_one();
+		}
+	}
+}
+
+/*
+ * Without workers the tasks are run in order by the calling thread.
+ */
+void ThreadPool::run(int numberOfTasks, const function<void(int, int)>& work) {
+	if (workers.empty()) {
+		for (int task = 0; task < numberOfTasks; task++) {
+			work(0, task);
+		}
+		return;
+	}
+	{
+		lock_guard<mutex> guard(lock);
+		this->work = &work;
+		this->numberOfTasks = numberOfTasks;
+		nextTask = 0;
+		busyWorkers = workers.size();
+		batchNumber++;
+	}
+	batchStarted.notify_all();
+	runTasks(0);
+	unique_lock<mutex> guard(lock);
+	batchFinished.wait(guard, [&] { return busyWorkers == 0; });
+}
+
+} /* namespace tdenum */
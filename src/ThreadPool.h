@@ -0,0 +1,53 @@
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+namespace tdenum {
+
+/**
+ * A fixed set of threads that runs batches of tasks. The threads are created
+ * once and wait between batches. The thread that runs a batch works on it as
+ * well, and every thread takes the next task that was not taken yet, so the
+ * work is divided dynamically.
+ */
+class ThreadPool {
+	vector<thread> workers;
+	mutex lock;
+	condition_variable batchStarted;
+	condition_variable batchFinished;
+	// The current batch, replaced by every call to run
+	const function<void(int,int)>* work;
+	int numberOfTasks;
+	atomic<int> nextTask;
+	long long batchNumber;
+	// The number of workers that did not finish the current batch
+	int busyWorkers;
+	bool isStopping;
+	// Takes the tasks of the current batch until none are left
+	void runTasks(int thread);
+	void runWorker(int thread);
+	// Disable copying
+	ThreadPool(const ThreadPool&);
+	ThreadPool& operator=(const ThreadPool&);
+public:
+	// Initialization with the given number of threads, including the one
+	// running the batches. A single thread creates no workers.
+	ThreadPool(int numberOfThreads);
+	~ThreadPool();
+	int getNumberOfThreads() const;
+	// Calls work(thread, task) for every task out of 0...numberOfTasks-1,
+	// where thread is out of 0...numberOfThreads-1 and is 0 for the calling
+	// thread. Returns when all the tasks are done.
+	void run(int numberOfTasks, const function<void(int thread, int task)>& work);
+};
+
+} /* namespace tdenum */
+
+#endif /* THREADPOOL_H_ */
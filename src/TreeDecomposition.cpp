@@ -5,24 +5,8 @@
 
 namespace tdenum {
     
-    // assumes that NodeSet contains a sorted vector
-    int getIntersectionSize(const NodeSet& b1, const NodeSet& b2) {
-        int weight = 0;
-        auto it1 = b1.begin();
-        auto it2 = b2.begin();
-        while (it1!=b1.end() && it2!=b2.end()) {
-            if (*it1<*it2) ++it1;
-            else if (*it2<*it1) ++it2;
-            else {
-                weight++;
-                ++it1; ++it2;
-            }
-        }
-        return weight;
-    }
-
     int TreeDecomposition::getEdgeWeight(const Edge& e) {
-        return -getIntersectionSize(bags[e.first], bags[e.second]);
+        return -bagBitsets[e.first].intersectionSize(bagBitsets[e.second]);
     }
 
     // Using Prim's algorithm for MST
@@ -56,8 +40,17 @@ namespace tdenum {
     
     TreeDecomposition::TreeDecomposition(const set<NodeSet>& inputBags) : bags() {
         if (inputBags.size() == 0) return;
-        for (auto b : inputBags) {
+        Node maxNode = 0;
+        for (const auto& b : inputBags) {
             bags.push_back(b);
+            // The bags are sorted, and an empty bag adds no node
+            if (!b.empty()) {
+                maxNode = max(maxNode, b.back());
+            }
+        }
+        // Bag intersections are computed for every pair of bags, so bitsets pay off
+        for (const auto& b : bags) {
+            bagBitsets.push_back(NodeBitset(maxNode+1, b));
         }
         makeTreeEdges();
     }
@@ -6,6 +6,7 @@
 #define TREEDECOMPOSITION_H_
 
 #include "Graph.h"
+#include "NodeBitset.h"
 #include <map>
 #include <deque>
 
@@ -15,6 +16,7 @@ typedef pair<int,int> Edge;
 
 class TreeDecomposition {
     vector<NodeSet> bags;
+    vector<NodeBitset> bagBitsets;
     vector<vector<pair<int,int>>> edgesOptions;
 	void makeTreeEdges();
 	void makeAllTreeEdgeOptions();
@@ -0,0 +1,100 @@
+#include "TwinReduction.h"
+#include <algorithm>
+
+namespace tdenum {
+
+/*
+ * Groups the nodes by their closed neighborhoods. The classes are numbered by
+ * their smallest node, and two classes are adjacent if their nodes are.
+ */
+TwinReduction::TwinReduction(const Graph& g) {
+	map<NodeSet, int> classOfNeighborhood;
+	vector<int> classOfNode(g.getNumberOfNodes());
+	for (Node v = 0; v < g.getNumberOfNodes(); v++) {
+		const set<Node>& neighbors = g.getNeighbors(v);
+		NodeSet closedNeighborhood(neighbors.begin(), neighbors.end());
+		closedNeighborhood.insert(
+				lower_bound(closedNeighborhood.begin(), closedNeighborhood.end(), v), v);
+		map<NodeSet, int>::iterator it = classOfNeighborhood.find(closedNeighborhood);
+		if (it == classOfNeighborhood.end()) {
+			it = classOfNeighborhood.insert(make_pair(closedNeighborhood, classes.size())).first;
+			classes.push_back(NodeSet());
+		}
+		classes[it->second].push_back(v);
+		classOfNode[v] = it->second;
+	}
+	quotientGraph = Graph(classes.size());
+	for (unsigned int i = 0; i < classes.size(); i++) {
+		for (Node u : g.getNeighbors(classes[i][0])) {
+			if (classOfNode[u] > (int)i) {
+				quotientGraph.addEdge(i, classOfNode[u]);
+			}
+		}
+	}
+}
+
+const Graph& TwinReduction::getQuotientGraph() const {
+	return quotientGraph;
+}
+
+bool TwinReduction::hasTwins() const {
+	for (const NodeSet& twins : classes) {
+		if (twins.size() > 1) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int TwinReduction::getWeight(Node v) const {
+	return classes[v].size();
+}
+
+int TwinReduction::getWeight(const NodeSet& nodes) const {
+	int weight = 0;
+	for (Node v : nodes) {
+		weight += classes[v].size();
+	}
+	return weight;
+}
+
+NodeSet TwinReduction::expand(const NodeSet& nodes) const {
+	NodeSet result;
+	for (Node v : nodes) {
+		result.insert(result.end(), classes[v].begin(), classes[v].end());
+	}
+	sort(result.begin(), result.end());
+	return result;
+}
+
+set<NodeSet> TwinReduction::expand(const set<NodeSet>& nodeSets) const {
+	set<NodeSet> result;
+	for (const NodeSet& nodes : nodeSets) {
+		result.insert(expand(nodes));
+	}
+	return result;
+}
+
+vector< set<Node> > TwinReduction::expandEdges(const vector< set<Node> >& edges) const {
+	vector< pair<Node,Node> > expandedEdges;
+	for (const set<Node>& edge : edges) {
+		const NodeSet& first = classes[*edge.begin()];
+		const NodeSet& second = classes[*edge.rbegin()];
+		for (Node u : first) {
+			for (Node v : second) {
+				expandedEdges.push_back(make_pair(min(u, v), max(u, v)));
+			}
+		}
+	}
+	sort(expandedEdges.begin(), expandedEdges.end());
+	vector< set<Node> > result;
+	for (unsigned int i = 0; i < expandedEdges.size(); i++) {
+		set<Node> edge;
+		edge.insert(expandedEdges[i].first);
+		edge.insert(expandedEdges[i].second);
+		result.push_back(edge);
+	}
+	return result;
+}
+
+} /* namespace tdenum */
@@ -0,0 +1,43 @@
+#ifndef TWINREDUCTION_H_
+#define TWINREDUCTION_H_
+
+#include "Graph.h"
+#include <map>
+
+namespace tdenum {
+
+/**
+ * Collapses the classes of true twins of a graph, which are nodes with the
+ * same closed neighborhood, into single nodes of a quotient graph.
+ * A minimal separator contains either all the nodes of a class or none of
+ * them, so the minimal triangulations of the graph are exactly the expansions
+ * of the minimal triangulations of the quotient graph, where every node is
+ * replaced by its class.
+ */
+class TwinReduction {
+	Graph quotientGraph;
+	// The nodes of the input graph in every node of the quotient graph,
+	// ordered by their smallest node
+	vector<NodeSet> classes;
+public:
+	TwinReduction(const Graph& g);
+	// Returns the graph in which every class of twins is a single node
+	const Graph& getQuotientGraph() const;
+	// Returns whether some node of the quotient graph stands for several nodes
+	bool hasTwins() const;
+	// Returns the number of input nodes in the given quotient node
+	int getWeight(Node v) const;
+	// Returns the number of input nodes in the given quotient nodes
+	int getWeight(const NodeSet& nodes) const;
+	// Returns the input nodes in the given quotient nodes
+	NodeSet expand(const NodeSet& nodes) const;
+	// Returns the input node sets obtained by expanding the given quotient node sets
+	set<NodeSet> expand(const set<NodeSet>& nodeSets) const;
+	// Returns the input edges between the classes connected by the given
+	// quotient edges, ordered as ChordalGraph::getFillEdges orders them
+	vector< set<Node> > expandEdges(const vector< set<Node> >& edges) const;
+};
+
+} /* namespace tdenum */
+
+#endif /* TWINREDUCTION_H_ */
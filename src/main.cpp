@@ -2,30 +2,229 @@
 #include <iomanip>
 #include <fstream>
 #include <ctime>
+#include <chrono>
 #include <cstdlib>
 #include <string>
+#include <filesystem>
 #include "GraphReader.h"
 #include "MinimalTriangulationsEnumerator.h"
+#include "MinimalSeparatorsEnumerator.h"
+#include "DecomposedTriangulationsEnumerator.h"
+#include "GraphDecomposer.h"
+#include "TwinReduction.h"
 #include "ResultsHandler.h"
+#include "Checkpoint.h"
 using namespace std;
 using namespace tdenum;
 
 
+/**
+ * Returns the wall clock time in seconds since the given time. The processor
+ * time would add up the time of all the threads.
+ */
+double getSecondsSince(chrono::steady_clock::time_point startTime) {
+	return chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+}
+
+/**
+ * Passes the results of the enumerator to the results handler until there are
+ * no more or the time limit is reached. Returns whether the time limit was reached.
+ */
+template<class Enumerator>
+bool enumerateResults(Enumerator& enumerator, ResultsHandler& results,
+		bool isTimeLimited, int timeLimitInSeconds, chrono::steady_clock::time_point startTime) {
+	while (enumerator.hasNext()) {
+		ChordalGraph triangulation = enumerator.next();
+		results.newResult(triangulation);
+		double totalTimeInSeconds = getSecondsSince(startTime);
+		if (isTimeLimited && totalTimeInSeconds >= timeLimitInSeconds) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * The statistics of an enumeration that are printed in the summary, and
+ * whether it could use its sets directory.
+ */
+struct EnumerationStatistics {
+	long long cacheHits;
+	long long cacheMisses;
+	long long extensionCacheHits;
+	long long extensionCacheMisses;
+	long long skippedExtensions;
+	bool isValid;
+	EnumerationStatistics() : cacheHits(0), cacheMisses(0), extensionCacheHits(0),
+			extensionCacheMisses(0), skippedExtensions(0), isValid(true) {}
+};
+
+template<class Enumerator>
+EnumerationStatistics getStatistics(const Enumerator& enumerator) {
+	EnumerationStatistics statistics;
+	statistics.cacheHits = enumerator.getNumberOfCacheHits();
+	statistics.cacheMisses = enumerator.getNumberOfCacheMisses();
+	statistics.extensionCacheHits = enumerator.getNumberOfExtensionCacheHits();
+	statistics.extensionCacheMisses = enumerator.getNumberOfExtensionCacheMisses();
+	statistics.skippedExtensions = enumerator.getNumberOfSkippedExtensions();
+	statistics.isValid = enumerator.isValid();
+	return statistics;
+}
+
+/**
+ * Writes the configuration of the run, the size of the output so far, and the
+ * states of the results handler and of the enumerator to the checkpoint file.
+ * Returns whether it was written. A state with sets that could not be read
+ * from the sets directory is not written.
+ */
+bool writeCheckpoint(const string& fileName, const string& configuration,
+		ofstream& output, ResultsHandler& results,
+		const MinimalTriangulationsEnumerator& enumerator) {
+	output.flush();
+	CheckpointWriter checkpoint(fileName);
+	checkpoint.writeString(configuration);
+	checkpoint.writeNumber(output.tellp());
+	results.save(checkpoint);
+	enumerator.save(checkpoint);
+	if (!enumerator.isValid()) {
+		return false;
+	}
+	return checkpoint.close();
+}
+
+/**
+ * Restores the results handler and the enumerator from the checkpoint file of
+ * a run with the same configuration. Returns the size the output had, or -1
+ * if the checkpoint cannot be used.
+ */
+long long readCheckpoint(const string& fileName, const string& configuration,
+		ResultsHandler& results, MinimalTriangulationsEnumerator& enumerator) {
+	CheckpointReader checkpoint(fileName);
+	if (checkpoint.readString() != configuration) {
+		return -1;
+	}
+	long long outputSize = checkpoint.readNumber();
+	results.load(checkpoint);
+	enumerator.load(checkpoint);
+	return checkpoint.isValid() ? outputSize : -1;
+}
+
+/**
+ * Like enumerateResults, and also writes a checkpoint every given number of
+ * seconds of wall clock time, and when the enumeration stops.
+ */
+bool enumerateResultsWithCheckpoints(MinimalTriangulationsEnumerator& enumerator,
+		ResultsHandler& results, ofstream& output, const string& checkpointFile,
+		const string& configuration, int checkpointInterval,
+		bool isTimeLimited, int timeLimitInSeconds, chrono::steady_clock::time_point startTime) {
+	bool timeLimitExceeded = false;
+	chrono::steady_clock::time_point lastCheckpointTime = chrono::steady_clock::now();
+	while (enumerator.hasNext()) {
+		ChordalGraph triangulation = enumerator.next();
+		results.newResult(triangulation);
+		if (getSecondsSince(lastCheckpointTime) >= checkpointInterval) {
+			if (!writeCheckpoint(checkpointFile, configuration, output, results, enumerator)) {
+				cout << "The checkpoint could not be written" << endl;
+			}
+			lastCheckpointTime = chrono::steady_clock::now();
+		}
+		double totalTimeInSeconds = getSecondsSince(startTime);
+		if (isTimeLimited && totalTimeInSeconds >= timeLimitInSeconds) {
+			timeLimitExceeded = true;
+			break;
+		}
+	}
+	if (!writeCheckpoint(checkpointFile, configuration, output, results, enumerator)) {
+		cout << "The checkpoint could not be written" << endl;
+	}
+	return timeLimitExceeded;
+}
+
+/**
+ * Enumerates the minimal separators of g, and prints every one whose size is
+ * within the limits as soon as it is generated, unless output is NULL.
+ * The separators are of the quotient graph if a reduction is given, and are
+ * expanded before they are measured and printed. Counts the printed separators
+ * by their size. Returns whether the time limit was reached.
+ * Without a reduction, the larger separators are not returned by the enumerator.
+ */
+bool enumerateSeparators(const Graph& g, const TwinReduction* reduction,
+		SeparatorsScoringCriterion order, int separatorThreads, int minSize, int maxSize,
+		ostream* output, map<int,string>& inputNaming, vector<long long>& countsBySize,
+		bool isTimeLimited, int timeLimitInSeconds, chrono::steady_clock::time_point startTime) {
+	MinimalSeparatorsEnumerator enumerator(g, order, separatorThreads,
+			reduction ? -1 : maxSize);
+	while (enumerator.hasNext()) {
+		MinimalSeparator separator = enumerator.next();
+		if (reduction) {
+			separator = reduction->expand(separator);
+		}
+		int size = separator.size();
+		if (size >= minSize && (maxSize < 0 || size <= maxSize)) {
+			if (size >= (int)countsBySize.size()) {
+				countsBySize.resize(size+1, 0);
+			}
+			countsBySize[size]++;
+			if (output) {
+				for (Node v : separator) {
+					*output << inputNaming[v] << " ";
+				}
+				*output << endl;
+			}
+		}
+		double totalTimeInSeconds = getSecondsSince(startTime);
+		if (isTimeLimited && totalTimeInSeconds >= timeLimitInSeconds) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Prints the number of minimal separators of every size, and their total.
+ */
+void printSeparatorCounts(const vector<long long>& countsBySize, ostream& output) {
+	long long total = 0;
+	for (unsigned int size = 0; size < countsBySize.size(); size++) {
+		if (countsBySize[size] > 0) {
+			output << "Size " << size << ": " << countsBySize[size]
+					<< " minimal separators" << endl;
+			total += countsBySize[size];
+		}
+	}
+	output << total << " minimal separators in total" << endl;
+}
+
+/*
+ * Prints the number of minimal triangulations of every atom, and their product.
+ */
+void printAtomCounts(DecomposedTriangulationsEnumerator& enumerator, ostream& output) {
+	vector<long long> counts = enumerator.countPieceTriangulations();
+	const vector<NodeSet>& atoms = enumerator.getPieces();
+	double total = 1;
+	for (unsigned int i = 0; i < atoms.size(); i++) {
+		output << "Atom #" << i+1 << " (" << atoms[i].size() << " nodes): "
+				<< counts[i] << " minimal triangulations" << endl;
+		total *= counts[i];
+	}
+	output << enumerator.getNumberOfCliquePieces()
+			<< " other atoms are cliques, with a single minimal triangulation" << endl;
+	output << fixed << setprecision(0) << total
+			<< " minimal triangulations in total" << endl;
+}
+
 /**
  * The first parameter is the graph file path.
  * Further parameters are optional flags.
  */
 int main(int argc, char* argv[]) {
 	
-	// Parse the input graph file
+	// Get the input graph file name
 	if (argc < 2) {
 		cout << "No graph file specified" << endl;
 		return 0;
 	}
 	string inputFile = argv[1];
-	pair<Graph, map <int,string> > graphInfo = GraphReader::read(inputFile);
-	Graph g = graphInfo.first;
-	map <int,string> inputNaming = graphInfo.second;
 
 	// Define the default parameters
 	bool isTimeLimited = false;
@@ -34,11 +233,38 @@ int main(int argc, char* argv[]) {
 	TriangulationScoringCriterion triangulationsOrder = NONE;
 	SeparatorsScoringCriterion separatorsOrder = UNIFORM;
 	OutputForm outputForm = TRIANGULATIONS;
+	bool separatorsOnly = false;
+	bool countSeparatorsOnly = false;
+	int minSeparatorSize = 0;
+	int maxSeparatorSize = -1;
+	bool decomposeToAtoms = false;
+	bool countAtomsOnly = false;
+	bool splitToComponents = true;
+	bool reduceTwins = false;
+	NodeOrdering ordering = INPUT_ORDER;
+	int separatorThreads = 1;
+	int extensionThreads = 1;
+	int enumerationThreads = 1;
+	int maxWidth = -1;
+	size_t cacheBytes = DEFAULT_COMPONENT_MAP_CACHE_BYTES;
+	int extensionCacheSize = DEFAULT_EXTENSION_CACHE_ENTRIES;
+	string checkpointFile;
+	int checkpointInterval = 600;
+	string resumeFile;
+	string externalDirectory;
+	// The input file and the flags that affect the results, which a resumed
+	// run must share with the run that wrote the checkpoint
+	string configuration = inputFile;
 	// Read the input parameters
 	for (int i=2; i<argc; i++) {
 		string argument = argv[i];
 		string flagName = argument.substr(0, argument.find_last_of("="));
 		string flagValue = argument.substr(argument.find_last_of("=")+1);
+		if (flagName != "time_limit" && flagName != "checkpoint" &&
+				flagName != "checkpoint_interval" && flagName != "resume" &&
+				flagName != "sets_dir") {
+			configuration += " " + argument;
+		}
 		if (flagName == "time_limit") {
 			timeLimitInSeconds = atoi(flagValue.c_str());
 			if (timeLimitInSeconds >= 0) {
@@ -53,6 +279,11 @@ int main(int argc, char* argv[]) {
 				outputForm = SINGLETDS;
 			} else if (flagValue == "TDsAll") {
 				outputForm = ALLTDS;
+			} else if (flagValue == "seps") {
+				separatorsOnly = true;
+			} else if (flagValue == "sepcount") {
+				separatorsOnly = true;
+				countSeparatorsOnly = true;
 			} else {
 				cout << "Output form not recognized" << endl;
 				return 0;
@@ -104,41 +335,263 @@ int main(int argc, char* argv[]) {
 				cout << "Seperators scoring criterion not recognized" << endl;
 				return 0;
 			}
+		} else if (flagName == "atoms") {
+			if (flagValue == "on") {
+				decomposeToAtoms = true;
+				countAtomsOnly = false;
+			} else if (flagValue == "count") {
+				decomposeToAtoms = true;
+				countAtomsOnly = true;
+			} else if (flagValue == "off") {
+				decomposeToAtoms = false;
+				countAtomsOnly = false;
+			} else {
+				cout << "Atoms option not recognized" << endl;
+				return 0;
+			}
+		} else if (flagName == "components") {
+			if (flagValue == "on") {
+				splitToComponents = true;
+			} else if (flagValue == "off") {
+				splitToComponents = false;
+			} else {
+				cout << "Components option not recognized" << endl;
+				return 0;
+			}
+		} else if (flagName == "twins") {
+			if (flagValue == "on") {
+				reduceTwins = true;
+			} else if (flagValue == "off") {
+				reduceTwins = false;
+			} else {
+				cout << "Twins option not recognized" << endl;
+				return 0;
+			}
+		} else if (flagName == "reorder") {
+			if (flagValue == "none") {
+				ordering = INPUT_ORDER;
+			} else if (flagValue == "rcm") {
+				ordering = REVERSE_CUTHILL_MCKEE;
+			} else if (flagValue == "degeneracy") {
+				ordering = DEGENERACY_ORDER;
+			} else {
+				cout << "Node ordering not recognized" << endl;
+				return 0;
+			}
+		} else if (flagName == "min_sep_size") {
+			minSeparatorSize = atoi(flagValue.c_str());
+		} else if (flagName == "max_sep_size") {
+			maxSeparatorSize = atoi(flagValue.c_str());
+		} else if (flagName == "max_width") {
+			maxWidth = atoi(flagValue.c_str());
+		} else if (flagName == "cache_mb") {
+			int cacheMegabytes = atoi(flagValue.c_str());
+			if (cacheMegabytes < 0) {
+				cout << "Cache size must not be negative" << endl;
+				return 0;
+			}
+			cacheBytes = (size_t)cacheMegabytes << 20;
+		} else if (flagName == "ext_cache") {
+			extensionCacheSize = atoi(flagValue.c_str());
+			if (extensionCacheSize < 0) {
+				cout << "Extension cache size must not be negative" << endl;
+				return 0;
+			}
+		} else if (flagName == "sep_threads") {
+			separatorThreads = atoi(flagValue.c_str());
+			if (separatorThreads < 1) {
+				cout << "Number of separator threads must be positive" << endl;
+				return 0;
+			}
+		} else if (flagName == "ext_threads") {
+			extensionThreads = atoi(flagValue.c_str());
+			if (extensionThreads < 1) {
+				cout << "Number of extension threads must be positive" << endl;
+				return 0;
+			}
+		} else if (flagName == "checkpoint") {
+			checkpointFile = flagValue;
+		} else if (flagName == "checkpoint_interval") {
+			checkpointInterval = atoi(flagValue.c_str());
+			if (checkpointInterval < 1) {
+				cout << "Checkpoint interval must be positive" << endl;
+				return 0;
+			}
+		} else if (flagName == "resume") {
+			resumeFile = flagValue;
+		} else if (flagName == "sets_dir") {
+			externalDirectory = flagValue;
+			if (!filesystem::is_directory(externalDirectory)) {
+				cout << "Sets directory not found" << endl;
+				return 0;
+			}
+		} else if (flagName == "threads") {
+			enumerationThreads = atoi(flagValue.c_str());
+			if (enumerationThreads < 1) {
+				cout << "Number of threads must be positive" << endl;
+				return 0;
+			}
+		}
+	}
+
+	// Parse the input graph file
+	pair<Graph, map <int,string> > graphInfo = GraphReader::read(inputFile, ordering);
+	Graph g = graphInfo.first;
+	map <int,string> inputNaming = graphInfo.second;
+
+	// Collapse the twins, and enumerate the triangulations of the quotient graph.
+	// The width of the quotient graph triangulations is not the width of their
+	// expansions, so they are not collapsed when the width is bounded.
+	if (reduceTwins && maxWidth >= 0 && !separatorsOnly) {
+		cout << "Twin reduction is not used with a bounded width" << endl;
+		reduceTwins = false;
+	}
+	TwinReduction* reduction = reduceTwins ? new TwinReduction(g) : NULL;
+	const Graph& enumeratedGraph = reduction ? reduction->getQuotientGraph() : g;
+
+	if (separatorsOnly) {
+		ofstream separatorsOutput;
+		string outputFileName = inputFile.substr(0, inputFile.find_last_of(".")) + "_out.txt";
+		if (!countSeparatorsOnly) {
+			separatorsOutput.open(outputFileName.c_str());
 		}
+		cout << setprecision(2);
+		cout << "Starting minimal separators enumeration for " << inputFile << endl;
+		chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+		vector<long long> countsBySize;
+		bool timeLimitExceeded = enumerateSeparators(enumeratedGraph, reduction,
+				separatorsOrder, separatorThreads, minSeparatorSize, maxSeparatorSize,
+				countSeparatorsOnly ? NULL : &separatorsOutput, inputNaming, countsBySize,
+				isTimeLimited, timeLimitInSeconds, startTime);
+		if (timeLimitExceeded) {
+			cout << "Time limit reached." << endl;
+		} else {
+			cout << "All minimal separators were generated!" << endl;
+		}
+		printSeparatorCounts(countsBySize, cout);
+		cout << "Took " << getSecondsSince(startTime) << " seconds" << endl;
+		if (!countSeparatorsOnly) {
+			separatorsOutput.close();
+			cout << "The separators were stored in the file " << outputFileName << endl;
+		}
+		delete reduction;
+		return 0;
+	}
+
+	// The parallel engine keeps the sets in memory, extends with one thread per
+	// worker, and returns the triangulations in the order they are found
+	if (enumerationThreads > 1 && (!externalDirectory.empty() || extensionThreads > 1 ||
+			triangulationsOrder != NONE)) {
+		cout << "The sets directory, extension threads and triangulations order are not supported with more than one enumeration thread" << endl;
+		delete reduction;
+		return 0;
+	}
+
+	if (countAtomsOnly) {
+		cout << "Counting minimal triangulations of the atoms of " << inputFile << endl;
+		DecomposedTriangulationsEnumerator enumerator(enumeratedGraph,
+				GraphDecomposer::getAtoms(enumeratedGraph),
+				triangulationsOrder, separatorsOrder, heuristic, separatorThreads, maxWidth,
+				cacheBytes, extensionThreads, enumerationThreads, externalDirectory,
+				extensionCacheSize);
+		printAtomCounts(enumerator, cout);
+		delete reduction;
+		return 0;
+	}
+
+	vector<NodeSet> pieces;
+	if (decomposeToAtoms) {
+		pieces = GraphDecomposer::getAtoms(enumeratedGraph);
+	} else if (splitToComponents) {
+		pieces = GraphDecomposer::getConnectedComponents(enumeratedGraph);
+	}
+	bool isCheckpointed = !checkpointFile.empty() || !resumeFile.empty();
+	if (isCheckpointed && (pieces.size() > 1 || enumerationThreads > 1)) {
+		cout << "Checkpoints are only supported for a single piece with one enumeration thread" << endl;
+		delete reduction;
+		return 0;
+	}
+	if (checkpointFile.empty()) {
+		// Keep writing checkpoints to the file the run was resumed from
+		checkpointFile = resumeFile;
 	}
 
 	// Open the output file
 	ofstream detailedOutput;
 	string outputFileName = inputFile.substr(0, inputFile.find_last_of(".")) + "_out.txt";
-	detailedOutput.open(outputFileName.c_str());
+	if (resumeFile.empty()) {
+		detailedOutput.open(outputFileName.c_str());
+	}
 	// Generate the results and print the details to the output file
 	cout << setprecision(2);
 	cout << "Starting enumeration for " << inputFile << endl;
-	clock_t startTime = clock();
-	ResultsHandler results(g, detailedOutput, outputForm, inputNaming);
+	chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+	ResultsHandler results(g, detailedOutput, outputForm, inputNaming, reduction);
 	bool timeLimitExceeded = false;
-	MinimalTriangulationsEnumerator enumerator(g, triangulationsOrder, separatorsOrder, heuristic);
-	int i=1;
-	while (enumerator.hasNext()) {
-		ChordalGraph triangulation = enumerator.next();
-		results.newResult(triangulation);
-		double totalTimeInSeconds = double(clock() - startTime) / CLOCKS_PER_SEC;
-		if (isTimeLimited && totalTimeInSeconds >= timeLimitInSeconds) {
-			timeLimitExceeded = true;
-			break;
+	EnumerationStatistics statistics;
+	if (pieces.size() > 1) {
+		DecomposedTriangulationsEnumerator enumerator(enumeratedGraph, pieces,
+				triangulationsOrder, separatorsOrder, heuristic, separatorThreads, maxWidth,
+				cacheBytes, extensionThreads, enumerationThreads, externalDirectory,
+				extensionCacheSize);
+		timeLimitExceeded = enumerateResults(enumerator, results,
+				isTimeLimited, timeLimitInSeconds, startTime);
+		statistics = getStatistics(enumerator);
+	} else {
+		MinimalTriangulationsEnumerator enumerator(enumeratedGraph,
+				triangulationsOrder, separatorsOrder, heuristic, separatorThreads, maxWidth,
+				cacheBytes, extensionThreads, enumerationThreads, externalDirectory,
+				extensionCacheSize);
+		if (!resumeFile.empty()) {
+			// Drop the results printed after the checkpoint, since they are found again
+			long long outputSize = readCheckpoint(resumeFile, configuration, results, enumerator);
+			error_code error;
+			if (outputSize >= 0) {
+				filesystem::resize_file(outputFileName, outputSize, error);
+			}
+			if (outputSize < 0 || error) {
+				cout << "The checkpoint does not match the input file and flags, or its output" << endl;
+				delete reduction;
+				return 0;
+			}
+			// Opened without truncating, at its end, so its size is known
+			detailedOutput.open(outputFileName.c_str(), ios::in | ios::out);
+			detailedOutput.seekp(0, ios::end);
+			cout << "Resuming from the checkpoint " << resumeFile << endl;
+		}
+		if (isCheckpointed) {
+			timeLimitExceeded = enumerateResultsWithCheckpoints(enumerator, results,
+					detailedOutput, checkpointFile, configuration, checkpointInterval,
+					isTimeLimited, timeLimitInSeconds, startTime);
+		} else {
+			timeLimitExceeded = enumerateResults(enumerator, results,
+					isTimeLimited, timeLimitInSeconds, startTime);
 		}
+		statistics = getStatistics(enumerator);
 	}
 	// Close the output file
 	detailedOutput.close();
 
 	// Print a summary to standard output
-	if (timeLimitExceeded) {
+	if (!statistics.isValid) {
+		cout << "The sets directory could not be used, so the enumeration was stopped." << endl;
+	} else if (timeLimitExceeded) {
 		cout << "Time limit reached." << endl;
 	} else {
 		cout << "All minimal triangulations were generated!" << endl;
 	}
 	results.printReadableSummary(cout);
+	if (cacheBytes > 0) {
+		cout << "Separator components maps cache: " << statistics.cacheHits << " hits, "
+				<< statistics.cacheMisses << " misses" << endl;
+	}
+	if (extensionCacheSize > 0) {
+		cout << "Extension cache: " << statistics.extensionCacheHits << " hits, "
+				<< statistics.extensionCacheMisses << " misses" << endl;
+	}
+	cout << "Extensions skipped: " << statistics.skippedExtensions << endl;
 	cout << "The detailed output was stored in the file " << outputFileName << endl;
+	delete reduction;
 
 	return 0;
 }